@@ -0,0 +1,111 @@
+#include "../../bench.hpp"
+#include "../../../include/DSA.hpp"
+
+/*
+ * Benchmarks for the maximum subarray sum
+ * Usage: max_subarray_sum_bench [n]
+ */
+
+int main(int argc, char** argv) {
+    size_t n = bench::size_arg(argc, argv, 50000000);
+    // daily P&L
+    auto pnl = bench::random_vector<double>(n, -100.0, 99.0);
+
+    std::printf("n = %zu\n", n);
+    // the loop max_subarray_sum_fast ran before
+    double base = bench::time_ms([&] {
+        double max = std::numeric_limits<double>::lowest(), sum = 0;
+        for(double x: pnl) {
+            sum = std::max(sum + x, x);
+            max = std::max(sum, max);
+        }
+        volatile double result = max;
+        (void) result;
+    });
+    bench::row("serial Kadane", base, base);
+    bench::row("max_subarray_sum_fast", bench::time_ms([&] { volatile double x = max_subarray_sum_fast(pnl); (void) x; }), base);
+    for(size_t threads: {1, 2, 4, 8}) {
+        std::string name = "parallel " + std::to_string(threads) + " threads";
+        bench::row(name.c_str(), bench::time_ms([&] {
+            volatile double x = std::get<2>(max_subarray_sum_parallel(pnl, threads)); (void) x;
+        }), base);
+    }
+
+    // divide and conquer over a view of the first million days, the recursion used to copy the vector
+    std::span<const double> days(pnl.data(), std::min<size_t>(n, 1000000));
+    double dc = bench::time_ms([&] { volatile double x = std::get<2>(max_subarray_sum(days)); (void) x; });
+    bench::row("divide and conquer 1M", dc, dc);
+    bench::row("divide and conquer 1M 4 threads", bench::time_ms([&] {
+        volatile double x = std::get<2>(max_subarray_sum(days, 4)); (void) x;
+    }), dc);
+
+    // range queries after point updates
+    MaxSubarrayTree<double> tree(days);
+    std::mt19937_64 e(42);
+    double rescan = bench::time_ms([&] {
+        double total = 0;
+        for(int q = 0; q < 100; q++) {
+            size_t l = e() % days.size(), r = l + e() % (days.size() - l);
+            total += std::get<2>(max_subarray_sum_parallel(days.subspan(l, r - l + 1), 1));
+        }
+        volatile double result = total;
+        (void) result;
+    });
+    bench::row("100 range rescans", rescan, rescan);
+    bench::row("100 tree update + query", bench::time_ms([&] {
+        double total = 0;
+        for(int q = 0; q < 100; q++) {
+            size_t l = e() % days.size(), r = l + e() % (days.size() - l);
+            tree.update(l, days[r]);
+            total += std::get<2>(tree.query(l, r));
+        }
+        volatile double result = total;
+        (void) result;
+    }), rescan);
+
+    // heat map anomaly: hottest subrectangle of a small grid against the brute force over corners
+    size_t rows = 60, cols = 80;
+    auto heat = bench::random_vector<double>(rows * cols, -1.0, 1.0);
+    double brute = bench::time_ms([&] {
+        std::vector<double> prefix((rows + 1) * (cols + 1), 0.0);
+        for(size_t r = 0; r < rows; r++)
+            for(size_t c = 0; c < cols; c++)
+                prefix[(r + 1) * (cols + 1) + c + 1] = heat[r * cols + c] + prefix[r * (cols + 1) + c + 1]
+                        + prefix[(r + 1) * (cols + 1) + c] - prefix[r * (cols + 1) + c];
+        double best = heat[0];
+        for(size_t top = 0; top < rows; top++)
+            for(size_t bottom = top; bottom < rows; bottom++)
+                for(size_t left = 0; left < cols; left++)
+                    for(size_t right = left; right < cols; right++)
+                        best = std::max(best, prefix[(bottom + 1) * (cols + 1) + right + 1] - prefix[top * (cols + 1) + right + 1]
+                                              - prefix[(bottom + 1) * (cols + 1) + left] + prefix[top * (cols + 1) + left]);
+        volatile double result = best;
+        (void) result;
+    });
+    bench::row("brute force 60x80 subrectangle", brute, brute);
+    for(size_t threads: {1, 4}) {
+        std::string name = "subrectangle 60x80 " + std::to_string(threads) + " threads";
+        bench::row(name.c_str(), bench::time_ms([&] {
+            volatile double x = std::get<4>(max_subrectangle_sum(heat, rows, cols, threads)); (void) x;
+        }), brute);
+    }
+
+    // weeks to quarters of the first million days
+    double window = bench::time_ms([&] {
+        double best = std::numeric_limits<double>::lowest();
+        for(size_t i = 0; i + 5 <= days.size(); i++) {
+            double sum = 0;
+            for(size_t length = 1; length <= 65 && i + length <= days.size(); length++) {
+                sum += days[i + length - 1];
+                if(length >= 5) best = std::max(best, sum);
+            }
+        }
+        volatile double result = best;
+        (void) result;
+    });
+    bench::row("brute force length 5 to 65", window, window);
+    bench::row("bounded length 5 to 65", bench::time_ms([&] {
+        volatile double x = std::get<2>(max_subarray_sum_bounded(days, 5, 65)); (void) x;
+    }), window);
+    return 0;
+}
@@ -0,0 +1,58 @@
+#include "../../bench.hpp"
+#include "../../../include/DSA.hpp"
+
+/*
+ * Benchmarks for selection and top k against a full sort
+ * Usage: order_statistics_bench [n] [k]
+ */
+
+int main(int argc, char** argv) {
+    size_t n = bench::size_arg(argc, argv, 10000000);
+    int k = argc > 2 ? std::atoi(argv[2]) : 100;
+    auto scores = bench::random_vector<int>(n, 0, std::numeric_limits<int>::max());
+
+    std::printf("n = %zu, k = %d\n", n, k);
+    double base = bench::time_ms(scores, [](auto &v) { pdqSort(v); });
+    bench::row("pdqSort", base, base);
+    bench::row("std::nth_element", bench::time_ms(scores, [](auto &v) {
+        std::nth_element(v.begin(), v.begin() + v.size() / 2, v.end());
+    }), base);
+    bench::row("nthElement median", bench::time_ms(scores, [](auto &v) { nthElement(v, (int) v.size() / 2); }), base);
+    bench::row("std::partial_sort", bench::time_ms(scores, [k](auto &v) {
+        std::partial_sort(v.begin(), v.begin() + k, v.end(), std::greater<>());
+    }), base);
+    bench::row("partialSort", bench::time_ms(scores, [k](auto &v) { partialSort(v, k, sorting::decreasingOrder<int>); }), base);
+    // reads the input in place, no copy
+    bench::row("topK", bench::time_ms([&] { topK(scores, k); }), base);
+
+    // inputs that defeat a median of three pivot, the 99th percentile as in a latency report
+    std::vector<int> organPipe(n), sawtooth(n);
+    for(size_t i = 0; i < n; i++) {
+        organPipe[i] = (int) (i < n / 2 ? i : n - i);
+        sawtooth[i] = (int) (i % 2 ? i : n - i);
+    }
+    int p99 = (int) (n / 100 * 99);
+    std::printf("\nn = %zu, 99th percentile\n", n);
+    base = bench::time_ms(scores, [p99](auto &v) { std::nth_element(v.begin(), v.begin() + p99, v.end()); });
+    bench::row("std::nth_element random", base, base);
+    bench::row("nthElement random", bench::time_ms(scores, [p99](auto &v) { nthElement(v, p99); }), base);
+    bench::row("nthElement organ pipe", bench::time_ms(organPipe, [p99](auto &v) { nthElement(v, p99); }), base);
+    bench::row("nthElement sawtooth", bench::time_ms(sawtooth, [p99](auto &v) { nthElement(v, p99); }), base);
+    bench::row("selectElement random", bench::time_ms([&] { selectElement(scores, p99 + 1); }), base);
+
+    // column scans
+    auto column = bench::random_vector<double>(n, -1e6, 1e6);
+    std::printf("\nn = %zu, column scans of doubles\n", n);
+    base = bench::time_ms([&] { volatile double x = *std::max_element(column.begin(), column.end()); (void) x; });
+    bench::row("std::max_element", base, base);
+    bench::row("maxVal", bench::time_ms([&] { volatile double x = maxVal(column); (void) x; }), base);
+    bench::row("std::minmax_element", bench::time_ms([&] {
+        volatile double x = *std::minmax_element(column.begin(), column.end()).first; (void) x;
+    }), base);
+    bench::row("minmaxVal", bench::time_ms([&] { volatile double x = minmaxVal(column).first; (void) x; }), base);
+    bench::row("argMax", bench::time_ms([&] { volatile size_t x = argMax(column); (void) x; }), base);
+    base = bench::time_ms([&] { volatile int x = *std::max_element(scores.begin(), scores.end()); (void) x; });
+    bench::row("std::max_element int", base, base);
+    bench::row("maxVal int", bench::time_ms([&] { volatile int x = maxVal(scores); (void) x; }), base);
+    return 0;
+}
@@ -0,0 +1,33 @@
+#include "../../bench.hpp"
+#include "../../../include/DSA.hpp"
+
+/*
+ * Scaling of parallelSort against the serial sorts
+ * Usage: parallel_sorting_bench [n] [grain]
+ */
+
+int main(int argc, char** argv) {
+    size_t n = bench::size_arg(argc, argv, 10000000);
+    size_t grain = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : parallel_sorting::DEFAULT_GRAIN;
+    auto input = bench::random_vector<int>(n, std::numeric_limits<int>::min(), std::numeric_limits<int>::max());
+    std::printf("n = %zu, grain = %zu, hardware threads = %u\n", n, grain, std::thread::hardware_concurrency());
+
+    double base = bench::time_ms(input, [](auto &v) { introSort(v); });
+    bench::row("introSort serial", base, base);
+    for(size_t threads: {1, 2, 4, 8, 16, 32}) {
+        bench::row("parallelSort QUICK_SORT " + std::to_string(threads) + " threads",
+                bench::time_ms(input, [&](auto &v) {
+                    parallelSort(v, sorting::increasingOrder<int>, parallel_sorting::QUICK_SORT, threads, grain);
+                }), base);
+    }
+
+    base = bench::time_ms(input, [](auto &v) { timSort(v); });
+    bench::row("timSort serial", base, base);
+    for(size_t threads: {1, 2, 4, 8, 16, 32}) {
+        bench::row("parallelSort MERGE_SORT " + std::to_string(threads) + " threads",
+                bench::time_ms(input, [&](auto &v) {
+                    parallelSort(v, sorting::increasingOrder<int>, parallel_sorting::MERGE_SORT, threads, grain);
+                }), base);
+    }
+    return 0;
+}
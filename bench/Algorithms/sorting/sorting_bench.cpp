@@ -0,0 +1,164 @@
+#include "../../bench.hpp"
+#include "../../../include/DSA.hpp"
+
+/*
+ * Benchmarks for the comparison sorts
+ * Usage: sorting_bench [n]
+ */
+
+int main(int argc, char** argv) {
+    size_t n = bench::size_arg(argc, argv, 1000000);
+    auto input = bench::random_vector<int>(n, std::numeric_limits<int>::min(), std::numeric_limits<int>::max());
+    // The comparator as it was passed before the sorts were templated on the comparator type
+    std::function<bool(int, int)> erased = [](const int &first, const int &second) {
+        return first > second;
+    };
+
+    std::printf("n = %zu (std::function vs sorting::increasingOrder)\n", n);
+
+    double base = bench::time_ms(input, [&](auto &v) { quickSort(v, erased); });
+    bench::row("quickSort std::function", base, base);
+    bench::row("quickSort functor", bench::time_ms(input, [](auto &v) { quickSort(v, sorting::increasingOrder<int>); }), base);
+
+    bench::row("pdqSort functor", bench::time_ms(input, [](auto &v) { pdqSort(v, sorting::increasingOrder<int>); }), base);
+    bench::row("introSort functor", bench::time_ms(input, [](auto &v) { introSort(v, sorting::increasingOrder<int>); }), base);
+
+    base = bench::time_ms(input, [&](auto &v) { mergeSort(v, erased); });
+    bench::row("mergeSort std::function", base, base);
+    bench::row("mergeSort functor", bench::time_ms(input, [](auto &v) { mergeSort(v, sorting::increasingOrder<int>); }), base);
+
+    bench::row("timSort functor", bench::time_ms(input, [](auto &v) { timSort(v, sorting::increasingOrder<int>); }), base);
+
+    std::vector<int> small(input.begin(), input.begin() + std::min<size_t>(n, 10000));
+    base = bench::time_ms(small, [&](auto &v) { insertionSort(v, erased); });
+    bench::row("insertionSort (10k) std::function", base, base);
+    bench::row("insertionSort (10k) functor", bench::time_ms(small, [](auto &v) { insertionSort(v, sorting::increasingOrder<int>); }), base);
+
+    // leaf sorts on consecutive blocks of 64 elements
+    base = bench::time_ms(input, [](auto &v) {
+        for(int low = 0; low + 64 <= (int) v.size(); low += 64) {
+            std::vector<int> block(v.begin() + low, v.begin() + low + 64);
+            insertionSort(block);
+            std::copy(block.begin(), block.end(), v.begin() + low);
+        }
+    });
+    bench::row("insertionSort blocks of 64", base, base);
+    bench::row("networkSort blocks of 64", bench::time_ms(input, [](auto &v) {
+        for(int low = 0; low + 64 <= (int) v.size(); low += 64) {
+            std::vector<int> block(v.begin() + low, v.begin() + low + 64);
+            networkSort(block, sorting::increasingOrder<int>, 0, 63);
+            std::copy(block.begin(), block.end(), v.begin() + low);
+        }
+    }), base);
+
+    std::vector<int> sorted(input);
+    introSort(sorted);
+    std::printf("\nn = %zu, already sorted input\n", n);
+    base = bench::time_ms(sorted, [](auto &v) { introSort(v); });
+    bench::row("introSort sorted", base, base);
+    std::vector<int> reversed(sorted.rbegin(), sorted.rend());
+    bench::row("introSort reversed", bench::time_ms(reversed, [](auto &v) { introSort(v); }), base);
+    bench::row("pdqSort sorted", bench::time_ms(sorted, [](auto &v) { pdqSort(v); }), base);
+    bench::row("pdqSort reversed", bench::time_ms(reversed, [](auto &v) { pdqSort(v); }), base);
+    bench::row("timSort sorted", bench::time_ms(sorted, [](auto &v) { timSort(v); }), base);
+    bench::row("timSort reversed", bench::time_ms(reversed, [](auto &v) { timSort(v); }), base);
+
+    // sorted blocks of 10k elements, as in concatenated event streams
+    std::vector<int> blocks(input);
+    for(size_t i = 0; i < n; i += 10000) {
+        std::sort(blocks.begin() + i, blocks.begin() + std::min(n, i + 10000));
+    }
+    std::printf("\nn = %zu, sorted blocks of 10000\n", n);
+    base = bench::time_ms(blocks, [](auto &v) { mergeSort(v); });
+    bench::row("mergeSort blocks", base, base);
+    bench::row("timSort blocks", bench::time_ms(blocks, [](auto &v) { timSort(v); }), base);
+
+    std::vector<int> duplicates(input);
+    for(auto &x: duplicates) x &= 7;
+    std::printf("\nn = %zu, 8 distinct keys\n", n);
+    base = bench::time_ms(duplicates, [](auto &v) { introSort(v); });
+    bench::row("introSort duplicates", base, base);
+    bench::row("pdqSort duplicates", bench::time_ms(duplicates, [](auto &v) { pdqSort(v); }), base);
+
+    auto timestamps = bench::random_vector<uint64_t>(n, 1600000000000000000ull, 1700000000000000000ull);
+    std::printf("\nn = %zu, 64-bit timestamps\n", n);
+    base = bench::time_ms(timestamps, [](auto &v) { pdqSort(v); });
+    bench::row("pdqSort timestamps", base, base);
+    bench::row("lsdRadixSort timestamps", bench::time_ms(timestamps, [](auto &v) { lsdRadixSort(v); }), base);
+    base = bench::time_ms(input, [](auto &v) { pdqSort(v); });
+    bench::row("pdqSort int32", base, base);
+    bench::row("lsdRadixSort int32", bench::time_ms(input, [](auto &v) { lsdRadixSort(v); }), base);
+
+    auto categories = bench::random_vector<uint16_t>(n, 0, 65535);
+    std::printf("\nn = %zu, 16-bit category ids\n", n);
+    base = bench::time_ms(categories, [](auto &v) { pdqSort(v); });
+    bench::row("pdqSort categories", base, base);
+    bench::row("lsdRadixSort categories", bench::time_ms(categories, [](auto &v) { lsdRadixSort(v); }), base);
+    bench::row("rangeCountingSort categories", bench::time_ms(categories, [](auto &v) {
+        rangeCountingSort(v, uint16_t(0), uint16_t(65535));
+    }), base);
+    bench::row("rangeCountingSort 4 threads", bench::time_ms(categories, [](auto &v) {
+        rangeCountingSort(v, uint16_t(0), uint16_t(65535), linear_sorting::INCREASING_ORDER, 4);
+    }), base);
+    struct Row {
+        uint16_t category;
+        uint32_t id;
+    };
+    std::vector<Row> rows(n);
+    for(size_t i = 0; i < n; i++) rows[i] = {categories[i], (uint32_t) i};
+    base = bench::time_ms(rows, [](auto &v) {
+        std::stable_sort(v.begin(), v.end(), [](const Row &a, const Row &b) { return a.category < b.category; });
+    });
+    bench::row("std::stable_sort rows", base, base);
+    bench::row("countingSortByKey rows", bench::time_ms(rows, [](auto &v) {
+        countingSortByKey(v, &Row::category, 0, 65535);
+    }), base);
+
+    auto doubles = bench::random_vector<double>(n, -1e6, 1e6);
+    std::printf("\nn = %zu, uniform doubles\n", n);
+    base = bench::time_ms(doubles, [](auto &v) { pdqSort(v); });
+    bench::row("pdqSort doubles", base, base);
+    bench::row("lsdRadixSort doubles", bench::time_ms(doubles, [](auto &v) { lsdRadixSort(v); }), base);
+    bench::row("bucketSort doubles", bench::time_ms(doubles, [](auto &v) { v = bucketSort(std::move(v)); }), base);
+
+    // URL like keys with a long shared prefix
+    std::vector<std::string> urls;
+    for(auto x: input) {
+        urls.push_back("https://example.com/api/v1/items/" + std::to_string((unsigned) x));
+    }
+    std::printf("\nn = %zu, strings with a shared prefix\n", n);
+    base = bench::time_ms(urls, [](auto &v) { std::sort(v.begin(), v.end()); });
+    bench::row("std::sort strings", base, base);
+    bench::row("pdqSort strings", bench::time_ms(urls, [](auto &v) { pdqSort(v); }), base);
+    bench::row("msdRadixSort strings", bench::time_ms(urls, [](auto &v) { msdRadixSort(v); }), base);
+    bench::row("msdRadixSort 4 threads", bench::time_ms(urls, [](auto &v) { msdRadixSort(v, linear_sorting::INCREASING_ORDER, 4); }), base);
+
+    // file paths, the first 13 bytes are shared and the next ones come from a few directories
+    std::vector<std::string> paths;
+    for(auto x: input) {
+        paths.push_back("/var/log/app/" + std::to_string((unsigned) x % 7) + "/" + std::to_string((unsigned) x) + ".log");
+    }
+    std::printf("\nn = %zu, paths with a shared prefix\n", n);
+    base = bench::time_ms(paths, [](auto &v) { std::sort(v.begin(), v.end()); });
+    bench::row("std::sort paths", base, base);
+    bench::row("msdRadixSort paths", bench::time_ms(paths, [](auto &v) { msdRadixSort(v); }), base);
+    bench::row("msdRadixSort paths 4 threads", bench::time_ms(paths, [](auto &v) { msdRadixSort(v, linear_sorting::INCREASING_ORDER, 4); }), base);
+
+    // 200 byte records sorted by an 8 byte timestamp
+    struct Record {
+        uint64_t ts;
+        char payload[192];
+    };
+    std::vector<Record> records(n);
+    for(size_t i = 0; i < n; i++) records[i].ts = timestamps[i];
+    std::printf("\nn = %zu, 200 byte records by timestamp\n", n);
+    base = bench::time_ms(records, [](auto &v) {
+        std::sort(v.begin(), v.end(), [](const Record &a, const Record &b) { return a.ts < b.ts; });
+    });
+    bench::row("std::sort records", base, base);
+    bench::row("sortBy records", bench::time_ms(records, [](auto &v) {
+        sortBy(v, sorting::increasingOrder<uint64_t>, &Record::ts);
+    }), base);
+    bench::row("argsort timestamps", bench::time_ms(timestamps, [](auto &v) { argsort(v); }), base);
+    return 0;
+}
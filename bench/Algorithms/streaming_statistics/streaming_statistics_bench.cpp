@@ -0,0 +1,60 @@
+#include "../../bench.hpp"
+#include "../../../include/DSA.hpp"
+
+/*
+ * Accuracy and memory of the quantile sketches against the exact selectElement
+ * Usage: streaming_statistics_bench [n]
+ */
+
+namespace {
+    const double QUANTILES[] = {0.5, 0.9, 0.99, 0.999};
+
+    // largest error in normalised rank of the sketch's quantiles
+    template<typename Sketch>
+        double maxRankError(const Sketch &sketch, const std::vector<double> &sorted) {
+            double error = 0;
+            for(double q: QUANTILES) {
+                double rank = (double) (std::upper_bound(sorted.begin(), sorted.end(), sketch.quantile(q)) - sorted.begin()) / sorted.size();
+                error = std::max(error, std::abs(rank - q));
+            }
+            return error;
+        }
+
+    template<typename Sketch>
+        void report(const char *name, Sketch sketch, size_t itemBytes, const std::vector<double> &latencies,
+                    const std::vector<double> &sorted) {
+            double ms = bench::time_ms([&] {
+                Sketch fresh = sketch;
+                for(double latency: latencies) fresh.insert(latency);
+                sketch = fresh;
+            }, 1);
+            std::printf("%-24s %10.2f ms %10zu B %12.6f\n", name, ms, sketch.retained() * itemBytes,
+                        maxRankError(sketch, sorted));
+        }
+}
+
+int main(int argc, char** argv) {
+    size_t n = bench::size_arg(argc, argv, 10000000);
+    std::mt19937_64 e(42);
+    std::lognormal_distribution<> distLatency(0, 1);
+    std::vector<double> latencies(n);
+    for(auto &latency: latencies) latency = distLatency(e);
+    std::vector<double> sorted(latencies);
+    std::sort(sorted.begin(), sorted.end());
+
+    std::printf("n = %zu lognormal latencies, p50 p90 p99 p99.9\n", n);
+    std::printf("%-24s %13s %12s %12s\n", "", "time", "memory", "rank error");
+    double ms = bench::time_ms([&] {
+        for(double q: QUANTILES) selectElement(latencies, (int) (q * n));
+    }, 1);
+    std::printf("%-24s %10.2f ms %10zu B %12.6f\n", "selectElement", ms, n * sizeof(double), 0.0);
+    for(int k: {50, 200, 800}) {
+        std::string name = "KLLSketch k = " + std::to_string(k);
+        report(name.c_str(), KLLSketch<double>(k), sizeof(double), latencies, sorted);
+    }
+    for(double compression: {50.0, 100.0, 400.0}) {
+        std::string name = "TDigest delta = " + std::to_string((int) compression);
+        report(name.c_str(), TDigest<double>(compression), sizeof(double) * 2, latencies, sorted);
+    }
+    return 0;
+}
@@ -0,0 +1,296 @@
+#include "../../bench.hpp"
+#include "../../../include/DSA.hpp"
+
+#include<algorithm>
+#include<string>
+#include<string_view>
+#include<type_traits>
+#include<unordered_map>
+
+/*
+ * Inserts the keys timing every insert, prints the total and the latency percentiles in microseconds
+ */
+template<typename Table>
+static void insert_latency(const char *name, Table &table, const std::vector<uint64_t> &keys) {
+    std::vector<double> latency(keys.size());
+    auto start = std::chrono::steady_clock::now();
+    for(size_t i = 0; i < keys.size(); i++) {
+        auto before = std::chrono::steady_clock::now();
+        table.insert(keys[i], i);
+        latency[i] = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - before).count();
+    }
+    double total = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::sort(latency.begin(), latency.end());
+    auto at = [&](double q) { return latency[(size_t) (q * (latency.size() - 1))]; };
+    std::printf("%-32s %10.2f %10.2f %10.2f %10.1f\n", name, total, at(0.5), at(0.999), latency.back());
+}
+
+/*
+ * Lookup time of HashTableOA with probing policy Probe filled to load_factor, hit_ratio of the
+ * lookups find their key
+ */
+template<ProbingPolicy Probe>
+static double probe_matrix_cell(const std::vector<uint64_t> &keys, size_t capacity, double load_factor, double hit_ratio) {
+    HashTableOA<uint64_t, uint64_t, Probe> table(capacity, 0.95);
+    size_t count = (size_t) (load_factor * capacity);
+    for(size_t i = 0; i < count; i++) table.insert(keys[i], i);
+    std::vector<uint64_t> lookups(count);
+    std::mt19937_64 e(3);
+    for(size_t i = 0; i < count; i++) {
+        bool hit = (double) (e() % 1000) < hit_ratio * 1000;
+        lookups[i] = hit ? keys[e() % count] : keys[count + e() % (keys.size() - count)];
+    }
+    return bench::time_ms([&] {
+        uint64_t hits = 0;
+        for(auto key: lookups) hits += table.contains_key(key);
+        volatile uint64_t result = hits;
+        (void) result;
+    });
+}
+
+/*
+ * Fills a linear probing HashTableOA using hasher, prints the mean, 99th percentile and longest probe
+ * length from its probe histogram and the ns per successful lookup
+ */
+template<typename Key, typename Hash>
+static void probe_lengths(const char *keys_name, const char *hash_name, const std::vector<Key> &keys, Hash hasher) {
+    HashTableOA<Key, uint64_t, probing::Linear, Hash> table(4, 0.8, false, hasher);
+    for(size_t i = 0; i < keys.size(); i++) table.insert(keys[i], i);
+    double ms = bench::time_ms([&] {
+        uint64_t hits = 0;
+        for(auto &key: keys) hits += table.contains_key(key);
+        volatile uint64_t result = hits;
+        (void) result;
+    });
+    auto histogram = table.probe_histogram();
+    size_t total = 0, seen = 0, p99 = 0;
+    for(size_t d = 0; d < histogram.size(); d++) total += d * histogram[d];
+    for(; seen += histogram[p99], 100 * seen < 99 * keys.size(); p99++);
+    std::printf("%-12s %-16s %8.2f %6zu %6zu %10.1f\n", keys_name, hash_name, (double) total / keys.size(), p99,
+                histogram.size() - 1, ms * 1e6 / keys.size());
+}
+
+/*
+ * Benchmarks for the hash tables, lookup heavy session cache
+ * Usage: hash_tables_bench [n]
+ */
+
+int main(int argc, char** argv) {
+    size_t n = bench::size_arg(argc, argv, 1000000);
+    // session ids, half of the lookups miss
+    auto sessions = bench::random_vector<uint64_t>(n, 0, std::numeric_limits<uint64_t>::max());
+    auto lookups = bench::random_vector<uint64_t>(4 * n, 0, 2 * n - 1, 7);
+
+    std::printf("n = %zu, %zu lookups\n", n, lookups.size());
+    auto key_of = [&](uint64_t i) { return i < n ? sessions[i] : sessions[i - n] ^ 1; };
+
+    std::unordered_map<uint64_t, uint64_t> baseline;
+    double base_insert = bench::time_ms([&] {
+        baseline = std::unordered_map<uint64_t, uint64_t>();
+        for(size_t i = 0; i < n; i++) baseline.emplace(sessions[i], i);
+    }, 1);
+    double base_lookup = bench::time_ms([&] {
+        uint64_t hits = 0;
+        for(auto i: lookups) hits += baseline.count(key_of(i));
+        volatile uint64_t result = hits;
+        (void) result;
+    });
+
+    HashTableOA<uint64_t, uint64_t> oa;
+    double oa_insert = bench::time_ms([&] {
+        oa.clear();
+        for(size_t i = 0; i < n; i++) oa.insert(sessions[i], i);
+    }, 1);
+    double oa_lookup = bench::time_ms([&] {
+        uint64_t hits = 0;
+        for(auto i: lookups) hits += oa.contains_key(key_of(i));
+        volatile uint64_t result = hits;
+        (void) result;
+    });
+
+    FlatHashMap<uint64_t, uint64_t> flat;
+    double flat_insert = bench::time_ms([&] {
+        flat = FlatHashMap<uint64_t, uint64_t>();
+        for(size_t i = 0; i < n; i++) flat.insert(sessions[i], i);
+    }, 1);
+    double flat_lookup = bench::time_ms([&] {
+        uint64_t hits = 0;
+        for(auto i: lookups) hits += flat.contains_key(key_of(i));
+        volatile uint64_t result = hits;
+        (void) result;
+    });
+
+    RobinHoodHashTable<uint64_t, uint64_t> robin;
+    double robin_insert = bench::time_ms([&] {
+        robin = RobinHoodHashTable<uint64_t, uint64_t>();
+        for(size_t i = 0; i < n; i++) robin.insert(sessions[i], i);
+    }, 1);
+    double robin_lookup = bench::time_ms([&] {
+        uint64_t hits = 0;
+        for(auto i: lookups) hits += robin.contains_key(key_of(i));
+        volatile uint64_t result = hits;
+        (void) result;
+    });
+
+    HashTable<uint64_t, uint64_t> chained;
+    double chained_insert = bench::time_ms([&] {
+        chained.clear();
+        for(size_t i = 0; i < n; i++) chained.insert(sessions[i], i);
+    }, 1);
+    double chained_lookup = bench::time_ms([&] {
+        uint64_t hits = 0;
+        for(auto i: lookups) hits += chained.get(key_of(i)).has_value();
+        volatile uint64_t result = hits;
+        (void) result;
+    });
+
+    PooledHashTable<uint64_t, uint64_t> pooled;
+    double pooled_insert = bench::time_ms([&] {
+        pooled = PooledHashTable<uint64_t, uint64_t>();
+        for(size_t i = 0; i < n; i++) pooled.insert(sessions[i], i);
+    }, 1);
+    double pooled_lookup = bench::time_ms([&] {
+        uint64_t hits = 0;
+        for(auto i: lookups) hits += pooled.find(key_of(i)) != nullptr;
+        volatile uint64_t result = hits;
+        (void) result;
+    });
+
+    bench::row("std::unordered_map insert", base_insert, base_insert);
+    bench::row("HashTableOA insert", oa_insert, base_insert);
+    bench::row("FlatHashMap insert", flat_insert, base_insert);
+    bench::row("RobinHoodHashTable insert", robin_insert, base_insert);
+    bench::row("HashTable insert", chained_insert, base_insert);
+    bench::row("PooledHashTable insert", pooled_insert, base_insert);
+    bench::row("std::unordered_map lookup", base_lookup, base_lookup);
+    bench::row("HashTableOA lookup", oa_lookup, base_lookup);
+    bench::row("FlatHashMap lookup", flat_lookup, base_lookup);
+    bench::row("RobinHoodHashTable lookup", robin_lookup, base_lookup);
+    bench::row("HashTable get", chained_lookup, base_lookup);
+    bench::row("PooledHashTable find", pooled_lookup, base_lookup);
+
+    // churn: every round expires the live window of sessions and opens the next one, then looks up
+    // the sessions that just expired. Only absent keys are inserted so that HashTableOA, which
+    // keeps duplicates, holds the same sessions as the others
+    size_t live = n / 4, rounds = 8;
+    auto churn = [&](auto &table) {
+        auto open = [&](uint64_t key, size_t i) {
+            if(!table.contains_key(key)) table.insert(key, i);
+        };
+        for(size_t i = 0; i < live; i++) open(sessions[i], i);
+        uint64_t hits = 0;
+        for(size_t r = 0; r < rounds; r++) {
+            for(size_t i = 0; i < live; i++) {
+                table.remove(sessions[(r * live + i) % n]);
+                open(sessions[((r + 1) * live + i) % n], i);
+            }
+            for(size_t i = 0; i < live; i++) hits += table.contains_key(sessions[(r * live + i) % n]);
+        }
+        volatile uint64_t result = hits;
+        (void) result;
+    };
+    double oa_churn = bench::time_ms([&] { HashTableOA<uint64_t, uint64_t> table; churn(table); }, 1);
+    bench::row("HashTableOA churn", oa_churn, oa_churn);
+    bench::row("FlatHashMap churn", bench::time_ms([&] { FlatHashMap<uint64_t, uint64_t> table; churn(table); }, 1), oa_churn);
+    bench::row("RobinHoodHashTable churn", bench::time_ms([&] { RobinHoodHashTable<uint64_t, uint64_t> table; churn(table); }, 1), oa_churn);
+    // probe policy x load factor x hit ratio, ns per lookup
+    size_t capacity = 1 << 20;
+    auto keys = bench::random_vector<uint64_t>(2 * capacity, 0, std::numeric_limits<uint64_t>::max(), 11);
+    std::printf("\nHashTableOA ns per lookup, %zu slots\n%-16s %6s %8s %8s %8s\n", capacity, "policy", "load", "hit 100%", "hit 50%", "hit 0%");
+    for(double load_factor: {0.5, 0.7, 0.9}) {
+        auto cells = [&](const char *name, auto cell) {
+            std::printf("%-16s %6.2f", name, load_factor);
+            for(double hit_ratio: {1.0, 0.5, 0.0}) {
+                double ms = cell(keys, capacity, load_factor, hit_ratio);
+                std::printf(" %8.1f", ms * 1e6 / (load_factor * capacity));
+            }
+            std::printf("\n");
+        };
+        cells("Linear", probe_matrix_cell<probing::Linear>);
+        cells("Quadratic", probe_matrix_cell<probing::Quadratic>);
+        cells("DoubleHashing", probe_matrix_cell<probing::DoubleHashing>);
+    }
+
+    // insert latency, stop the world against incremental resize
+    std::printf("\n%-32s %10s %10s %10s %10s\n", "insert latency", "total ms", "p50 us", "p99.9 us", "max us");
+    {
+        HashTableOA<uint64_t, uint64_t> table;
+        insert_latency("HashTableOA", table, sessions);
+    }
+    {
+        HashTableOA<uint64_t, uint64_t> table(4, 0.8, true);
+        insert_latency("HashTableOA incremental", table, sessions);
+    }
+    {
+        HashTable<uint64_t, uint64_t> table;
+        insert_latency("HashTable", table, sessions);
+    }
+    {
+        HashTable<uint64_t, uint64_t> table(3, 1.2, true);
+        insert_latency("HashTable incremental", table, sessions);
+    }
+
+    // string keyed config cache, keys looked up through views into the request text. get of a
+    // std::string built from the view is the old allocating lookup
+    size_t settings = std::max<size_t>(1, n / 16);
+    std::string request;
+    std::vector<std::pair<size_t, size_t>> spans;
+    for(auto i: lookups) {
+        std::string key = "config.service-" + std::to_string(i % (2 * settings)) + ".timeout_ms";
+        spans.emplace_back(request.size(), key.size());
+        request += key + ';';
+    }
+    auto config = [&](auto &table, auto lookup) {
+        for(size_t i = 0; i < settings; i++) {
+            table.try_emplace("config.service-" + std::to_string(i) + ".timeout_ms", i);
+        }
+        return bench::time_ms([&] {
+            uint64_t hits = 0;
+            for(auto [offset, length]: spans) hits += lookup(table, std::string_view(request).substr(offset, length));
+            volatile uint64_t result = hits;
+            (void) result;
+        });
+    };
+    auto by_string = [](auto &table, std::string_view key) { return table.get(std::string(key)).has_value(); };
+    auto by_view = [](auto &table, std::string_view key) { return table.find(key) != nullptr; };
+    std::printf("\nconfig cache, %zu keys, %zu lookups\n", settings, spans.size());
+    {
+        HashTableOA<std::string, uint64_t> table;
+        double get = config(table, by_string);
+        bench::row("HashTableOA get(string)", get, get);
+        bench::row("HashTableOA find(string_view)", config(table, by_view), get);
+    }
+    {
+        FlatHashMap<std::string, uint64_t> table;
+        double get = config(table, by_string);
+        bench::row("FlatHashMap get(string)", get, get);
+        bench::row("FlatHashMap find(string_view)", config(table, by_view), get);
+    }
+
+    // probe length distribution per hash, few keys since std::hash on strided keys is quadratic
+    size_t count = std::min<size_t>(n, 1 << 14);
+    std::vector<uint64_t> sequential(count), strided(count);
+    std::vector<std::string> names(count);
+    for(size_t i = 0; i < count; i++) {
+        sequential[i] = i;
+        strided[i] = i << 10;
+        names[i] = "session-" + std::to_string(i);
+    }
+    std::vector<uint64_t> random(sessions.begin(), sessions.begin() + count);
+    std::printf("\nHashTableOA linear probing, %zu keys\n%-12s %-16s %8s %6s %6s %10s\n", count, "keys", "hash",
+                "mean", "p99", "max", "lookup ns");
+    auto per_hash = [&](const char *keys_name, const auto &keys) {
+        using Key = typename std::decay_t<decltype(keys)>::value_type;
+        probe_lengths(keys_name, "std::hash", keys, std::hash<lookup_key_t<Key>>());
+        probe_lengths(keys_name, "WyHash", keys, hashing::WyHash());
+        probe_lengths(keys_name, "WyHash seeded", keys, hashing::WyHash::seeded());
+    };
+    per_hash("sequential", sequential);
+    per_hash("strided", strided);
+    per_hash("random", random);
+    per_hash("strings", names);
+
+    auto histogram = robin.probe_histogram();
+    std::printf("RobinHoodHashTable longest probe %zu\n", histogram.size());
+    return 0;
+}
@@ -0,0 +1,78 @@
+/** @file bench.hpp
+ * @brief Benchmark helpers
+ * @details Minimal timing and input generation helpers shared by the benchmark executables.
+ */
+#ifndef DSA_BENCH_HPP
+#define DSA_BENCH_HPP
+
+#include<chrono>
+#include<cstdio>
+#include<cstdlib>
+#include<limits>
+#include<random>
+#include<string>
+#include<vector>
+
+namespace bench {
+
+    /*
+     * Runs fn on a fresh copy of the input `runs` times and returns the best wall time in milliseconds
+     */
+    template<typename T, typename Fn>
+        double time_ms(const std::vector<T> &input, Fn fn, int runs = 3) {
+            double best = std::numeric_limits<double>::max();
+            for(int r = 0; r < runs; r++) {
+                std::vector<T> v(input);
+                auto start = std::chrono::steady_clock::now();
+                fn(v);
+                auto end = std::chrono::steady_clock::now();
+                double ms = std::chrono::duration<double, std::milli>(end - start).count();
+                if(ms < best) best = ms;
+            }
+            return best;
+        }
+
+    /*
+     * Runs fn `runs` times and returns the best wall time in milliseconds
+     */
+    template<typename Fn>
+        double time_ms(Fn fn, int runs = 3) {
+            double best = std::numeric_limits<double>::max();
+            for(int r = 0; r < runs; r++) {
+                auto start = std::chrono::steady_clock::now();
+                fn();
+                auto end = std::chrono::steady_clock::now();
+                double ms = std::chrono::duration<double, std::milli>(end - start).count();
+                if(ms < best) best = ms;
+            }
+            return best;
+        }
+
+    template<typename T>
+        std::vector<T> random_vector(size_t n, T low, T high, unsigned seed = 42) {
+            std::mt19937_64 e(seed);
+            std::vector<T> v(n);
+            if constexpr (std::is_floating_point_v<T>) {
+                std::uniform_real_distribution<T> dist(low, high);
+                for(auto &x: v) x = dist(e);
+            } else {
+                std::uniform_int_distribution<T> dist(low, high);
+                for(auto &x: v) x = dist(e);
+            }
+            return v;
+        }
+
+    /*
+     * Problem size from the first command line argument, falls back to `fallback`
+     */
+    inline size_t size_arg(int argc, char** argv, size_t fallback) {
+        if(argc > 1) return std::strtoull(argv[1], nullptr, 10);
+        return fallback;
+    }
+
+    inline void row(const std::string &name, double ms, double baseline_ms) {
+        std::printf("%-40s %10.2f ms  %6.2fx\n", name.c_str(), ms, baseline_ms / ms);
+    }
+}
+
+#endif //DSA_BENCH_HPP
@@ -5,13 +5,25 @@
 #include"../src/Algorithms/sorting/sorting.hpp"
 #include"../src/Algorithms/sorting/sorting.cpp"
 
+#include"../src/Algorithms/sorting/sorting_network.hpp"
+#include"../src/Algorithms/sorting/sorting_network.cpp"
+
 #include"../src/Algorithms/sorting/linear_sorting.hpp"
 #include"../src/Algorithms/sorting/linear_sorting.cpp"
 
+#include"../src/Algorithms/sorting/parallel_sorting.hpp"
+#include"../src/Algorithms/sorting/parallel_sorting.cpp"
+
+#include"../src/Algorithms/sorting/key_sorting.hpp"
+#include"../src/Algorithms/sorting/key_sorting.cpp"
+
 #include"../src/Algorithms/max_subarray_sum/max_subarray_sum.hpp"
 #include"../src/Algorithms/max_subarray_sum/max_subarray_sum.cpp"
 
 #include"../src/Algorithms/order_statistics/order_statistics.hpp"
 #include"../src/Algorithms/order_statistics/order_statistics.cpp"
 
+#include"../src/Algorithms/streaming_statistics/streaming_statistics.hpp"
+#include"../src/Algorithms/streaming_statistics/streaming_statistics.cpp"
+
 #endif //ALGORITHMS_ALGORITHM_HPP
@@ -26,5 +26,14 @@
 #include"../src/Data_structures/hash_tables/hash_table_open_addressing.hpp"
 #include"../src/Data_structures/hash_tables/hash_table_open_addressing.cpp"
 
+#include"../src/Data_structures/hash_tables/flat_hash_map.hpp"
+#include"../src/Data_structures/hash_tables/flat_hash_map.cpp"
+
+#include"../src/Data_structures/hash_tables/robin_hood_hash_table.hpp"
+#include"../src/Data_structures/hash_tables/robin_hood_hash_table.cpp"
+
+#include"../src/Data_structures/hash_tables/pooled_hash_table.hpp"
+#include"../src/Data_structures/hash_tables/pooled_hash_table.cpp"
+
 
 //#endif //DATA_STRUCTURES_DS_HPP
@@ -1,25 +1,143 @@
 #include "max_subarray_sum.hpp"
 
+/*
+ * Summary of the single element segment A[i..i]
+ */
+template<Arithmetic T>
+static max_subarray::Summary<T> single(T x, size_t i) {
+    return max_subarray::Summary<T>{x, x, i, x, i, x, i, i};
+}
+
+/*
+ * Summary of the segment left followed by the segment right, associative
+ */
+template<Arithmetic T>
+static max_subarray::Summary<T> combine(const max_subarray::Summary<T> &left, const max_subarray::Summary<T> &right) {
+    max_subarray::Summary<T> s;
+    s.total = left.total + right.total;
+    if (left.prefix >= left.total + right.prefix) {
+        s.prefix = left.prefix;
+        s.prefix_high = left.prefix_high;
+    } else {
+        s.prefix = left.total + right.prefix;
+        s.prefix_high = right.prefix_high;
+    }
+    if (right.suffix >= left.suffix + right.total) {
+        s.suffix = right.suffix;
+        s.suffix_low = right.suffix_low;
+    } else {
+        s.suffix = left.suffix + right.total;
+        s.suffix_low = left.suffix_low;
+    }
+    T cross = left.suffix + right.prefix;
+    if (left.best >= right.best && left.best >= cross) {
+        s.best = left.best;
+        s.best_low = left.best_low;
+        s.best_high = left.best_high;
+    } else if (cross >= right.best) {
+        s.best = cross;
+        s.best_low = left.suffix_low;
+        s.best_high = right.prefix_high;
+    } else {
+        s.best = right.best;
+        s.best_low = right.best_low;
+        s.best_high = right.best_high;
+    }
+    return s;
+}
+
+/*
+ * Summary of A[low..high) in one Kadane pass over STRIPS interleaved strips, so that the
+ * scans of the strips overlap instead of waiting on one running sum
+ */
+template<Arithmetic T>
+static max_subarray::Summary<T> summarise_chunk(const T *v, size_t low, size_t high) {
+    constexpr int S = max_subarray::STRIPS;
+    size_t length = (high - low) / S;
+    if (length == 0) {
+        max_subarray::Summary<T> s = single(v[low], low);
+        for (size_t i = low + 1; i < high; i++) {
+            s = combine(s, single(v[i], i));
+        }
+        return s;
+    }
+    // strip k covers A[begin[k]..begin[k] + length), the last one takes the remainder
+    size_t begin[S];
+    T running[S], min_before[S], current[S];
+    size_t min_at[S], current_low[S];
+    max_subarray::Summary<T> s[S];
+    for (int k = 0; k < S; k++) {
+        begin[k] = low + k * length;
+        T first = v[begin[k]];
+        running[k] = first;
+        min_before[k] = (T) 0;
+        min_at[k] = begin[k];
+        current[k] = first;
+        current_low[k] = begin[k];
+        s[k] = single(first, begin[k]);
+    }
+    auto step = [&](int k, size_t i) {
+        T x = v[i];
+        // the best suffix starts right after the smallest prefix sum
+        if (running[k] < min_before[k]) {
+            min_before[k] = running[k];
+            min_at[k] = i;
+        }
+        running[k] += x;
+        if (running[k] > s[k].prefix) {
+            s[k].prefix = running[k];
+            s[k].prefix_high = i;
+        }
+        if (current[k] > (T) 0) {
+            current[k] += x;
+        } else {
+            current[k] = x;
+            current_low[k] = i;
+        }
+        if (current[k] > s[k].best) {
+            s[k].best = current[k];
+            s[k].best_low = current_low[k];
+            s[k].best_high = i;
+        }
+    };
+    for (size_t j = 1; j < length; j++) {
+        for (int k = 0; k < S; k++) {
+            step(k, begin[k] + j);
+        }
+    }
+    for (size_t i = begin[S - 1] + length; i < high; i++) {
+        step(S - 1, i);
+    }
+    max_subarray::Summary<T> result;
+    for (int k = 0; k < S; k++) {
+        s[k].total = running[k];
+        s[k].suffix = running[k] - min_before[k];
+        s[k].suffix_low = min_at[k];
+        result = k == 0 ? s[k] : combine(result, s[k]);
+    }
+    return result;
+}
+
 /*
  * Find the max subarray of the form A[i..j] where j >= mid and i <= mid
  * The problem is divided to find two array of the form A[i..mid] and A[mid+1..j]
  * Returns a tuple consisting of the indices demarcating the subarray and the sum of the subarray
  */
 template<Arithmetic T>
-static std::tuple<int, int, T> max_crossing_subarray(std::vector<T> v, int low, int mid, int high) {
-    T left_sum = std::numeric_limits<T>::min();
+static std::tuple<size_t, size_t, T> max_crossing_subarray(std::span<const T> v, size_t low, size_t mid, size_t high) {
+    T left_sum = std::numeric_limits<T>::lowest();
     T sum = (T) 0;
-    int max_left, max_right;
-    for (int i = mid; i >= low; i--) {
+    size_t max_left = mid, max_right = mid + 1;
+    for (size_t i = mid + 1; i-- > low;) {
         sum += v[i];
         if (sum > left_sum) {
             left_sum = sum;
             max_left = i;
         }
     }
-    T right_sum = std::numeric_limits<T>::min();
+    T right_sum = std::numeric_limits<T>::lowest();
     sum = (T) 0;
-    for (int j = mid + 1; j <= high; j++) {
+    for (size_t j = mid + 1; j <= high; j++) {
         sum += v[j];
         if (sum > right_sum) {
             right_sum = sum;
@@ -35,20 +153,31 @@ static std::tuple<int, int, T> max_crossing_subarray(std::vector<T> v, int low,
  *  -> A[i..j]; i,j < mid
  *  -> A[i..mid]+A[mid+1..j]
  *  -> A[i..j]; i,j > mid
+ * With a pool the left half of a large enough segment is forked as a task
  */
 template<Arithmetic T>
-static std::tuple<int, int, T> max_subarray_sum_recur(std::vector<T> v, int low, int high) {
-    int left_low, left_high;
-    int right_low, right_high;
-    int cross_low, cross_high;
+static std::tuple<size_t, size_t, T> max_subarray_sum_recur(std::span<const T> v, size_t low, size_t high, ThreadPool *pool) {
+    size_t left_low, left_high;
+    size_t right_low, right_high;
+    size_t cross_low, cross_high;
     T left_sum, right_sum, cross_sum;
     if (low == high) {
         return std::make_tuple(low, high, v[low]);
     } else {
-        int mid = (low + high) / 2;
-        std::tie(left_low, left_high, left_sum) = max_subarray_sum_recur(v, low, mid);
-        std::tie(right_low, right_high, right_sum) = max_subarray_sum_recur(v, mid + 1, high);
-        std::tie(cross_low, cross_high, cross_sum) = max_crossing_subarray(v, low, mid, high);
+        size_t mid = low + (high - low) / 2;
+        if (pool != nullptr && high - low >= max_subarray::PARALLEL_GRAIN) {
+            TaskGroup group(*pool);
+            group.run([&, v, low, mid, pool]() {
+                std::tie(left_low, left_high, left_sum) = max_subarray_sum_recur(v, low, mid, pool);
+            });
+            std::tie(right_low, right_high, right_sum) = max_subarray_sum_recur(v, mid + 1, high, pool);
+            std::tie(cross_low, cross_high, cross_sum) = max_crossing_subarray(v, low, mid, high);
+            group.wait();
+        } else {
+            std::tie(left_low, left_high, left_sum) = max_subarray_sum_recur(v, low, mid, pool);
+            std::tie(right_low, right_high, right_sum) = max_subarray_sum_recur(v, mid + 1, high, pool);
+            std::tie(cross_low, cross_high, cross_sum) = max_crossing_subarray(v, low, mid, high);
+        }
         if (left_sum >= right_sum && left_sum >= cross_sum)
             return std::make_tuple(left_low, left_high, left_sum);
         else if (right_sum >= left_sum && right_sum >= cross_sum)
@@ -62,9 +191,16 @@ static std::tuple<int, int, T> max_subarray_sum_recur(std::vector<T> v, int low,
  * Returns the tuple consisting of the indices demarcating
  * the subarray and the maximum sum
  */
-template<Arithmetic T>
-std::tuple<int, int, T> max_subarray_sum(std::vector<T> v) {
-    return max_subarray_sum_recur(v, 0, v.size() - 1);
+template<std::ranges::contiguous_range Range, Arithmetic T>
+std::tuple<size_t, size_t, T> max_subarray_sum(const Range &v, size_t threads) {
+    std::span<const T> values(std::ranges::data(v), std::ranges::size(v));
+    if (values.empty()) throw std::runtime_error("Empty vector");
+    if (threads == 0) threads = std::thread::hardware_concurrency();
+    if (threads <= 1 || values.size() < 2 * max_subarray::PARALLEL_GRAIN) {
+        return max_subarray_sum_recur(values, 0, values.size() - 1, (ThreadPool*) nullptr);
+    }
+    ThreadPool pool(threads);
+    return max_subarray_sum_recur(values, 0, values.size() - 1, &pool);
 }
 
 /*
@@ -72,12 +208,203 @@ std::tuple<int, int, T> max_subarray_sum(std::vector<T> v) {
  * returns just the maximum sum without the sub-array indices
  */
 template <Arithmetic T>
-T max_subarray_sum_fast(std::vector<T> v) {
-  T max = std::numeric_limits<T>::min();
-  T sum = (T)0;
-  for(const auto& elm: v) {
-    sum = std::max(sum + elm, elm);
-    max = std::max(sum, max);
+T max_subarray_sum_fast(const std::vector<T> &v) {
+  if(v.empty()) return std::numeric_limits<T>::lowest();
+  return std::get<2>(max_subarray_sum_parallel(v, 1));
+}
+
+/*
+ * Summaries of the chunks computed in parallel then combined from left to right
+ */
+template<std::ranges::contiguous_range Range, Arithmetic T>
+std::tuple<size_t, size_t, T> max_subarray_sum_parallel(const Range &v, size_t threads) {
+  std::span<const T> values(std::ranges::data(v), std::ranges::size(v));
+  size_t n = values.size();
+  if(n == 0) throw std::runtime_error("Empty vector");
+  if(threads == 0) threads = std::thread::hardware_concurrency();
+  size_t chunks = std::max<size_t>(1, std::min(threads, n / max_subarray::PARALLEL_GRAIN));
+  std::vector<max_subarray::Summary<T>> summaries(chunks);
+  if(chunks == 1) {
+    summaries[0] = summarise_chunk(values.data(), 0, n);
+  } else {
+    ThreadPool pool(chunks);
+    TaskGroup group(pool);
+    for(size_t c = 0; c < chunks; c++) {
+      group.run([&summaries, &values, c, n, chunks]() {
+        summaries[c] = summarise_chunk(values.data(), n * c / chunks, n * (c + 1) / chunks);
+      });
+    }
+    group.wait();
+  }
+  max_subarray::Summary<T> total = summaries[0];
+  for(size_t c = 1; c < chunks; c++) {
+    total = combine(total, summaries[c]);
   }
-  return max;
+  return std::make_tuple(total.best_low, total.best_high, total.best);
+}
+
+/*
+ * Lines along the shorter side are paired, line pairs starting at first, first + threads, ... 
+ * run on the same thread so that the long and short pairs are spread evenly
+ */
+template<std::ranges::contiguous_range Range, Arithmetic T>
+std::tuple<size_t, size_t, size_t, size_t, T> max_subrectangle_sum(const Range &grid, size_t rows, size_t cols, size_t threads) {
+    std::span<const T> values(std::ranges::data(grid), std::ranges::size(grid));
+    if (values.empty()) throw std::runtime_error("Empty vector");
+    if (values.size() != rows * cols) throw std::invalid_argument("Grid size mismatch");
+    // lines are rows when there are fewer rows, else columns
+    bool by_rows = rows <= cols;
+    size_t lines = by_rows ? rows : cols, length = by_rows ? cols : rows;
+    // columns are transposed once so that every line is contiguous
+    std::vector<T> transposed;
+    const T *data = values.data();
+    if (!by_rows) {
+        transposed.resize(values.size());
+        for (size_t r = 0; r < rows; r++) {
+            for (size_t c = 0; c < cols; c++) {
+                transposed[c * rows + r] = values[r * cols + c];
+            }
+        }
+        data = transposed.data();
+    }
+    if (threads == 0) threads = std::thread::hardware_concurrency();
+    threads = std::max<size_t>(1, std::min(threads, lines));
+    // best subrectangle of each thread as first line, last line, summary
+    using Best = std::tuple<size_t, size_t, max_subarray::Summary<T>>;
+    std::vector<Best> best(threads);
+    auto scan = [&](size_t t) {
+        std::vector<T> sums(length);
+        Best &result = best[t];
+        bool found = false;
+        for (size_t first = t; first < lines; first += threads) {
+            std::fill(sums.begin(), sums.end(), (T) 0);
+            for (size_t last = first; last < lines; last++) {
+                const T *line = data + last * length;
+                for (size_t k = 0; k < length; k++) {
+                    sums[k] += line[k];
+                }
+                max_subarray::Summary<T> s = summarise_chunk(sums.data(), 0, length);
+                if (!found || s.best > std::get<2>(result).best) {
+                    result = Best(first, last, s);
+                    found = true;
+                }
+            }
+        }
+    };
+    if (threads == 1) {
+        scan(0);
+    } else {
+        ThreadPool pool(threads);
+        TaskGroup group(pool);
+        for (size_t t = 0; t < threads; t++) {
+            group.run([&scan, t]() { scan(t); });
+        }
+        group.wait();
+    }
+    // ties go to the earliest first line
+    Best result = best[0];
+    for (size_t t = 1; t < threads; t++) {
+        auto &[first, last, s] = best[t];
+        auto &[best_first, best_last, best_s] = result;
+        if (s.best > best_s.best || (s.best == best_s.best && first < best_first)) result = best[t];
+    }
+    auto &[first, last, s] = result;
+    if (by_rows) return std::make_tuple(first, s.best_low, last, s.best_high, s.best);
+    return std::make_tuple(s.best_low, first, s.best_high, last, s.best);
+}
+
+/*
+ * prefix[j] - prefix[i] is the sum of A[i..j - 1]. The deque holds the candidate starts of the 
+ * window with increasing prefix sums, so its front is the best start for the end j
+ */
+template<std::ranges::contiguous_range Range, Arithmetic T>
+std::tuple<size_t, size_t, T> max_subarray_sum_bounded(const Range &v, size_t min_length, size_t max_length) {
+    std::span<const T> values(std::ranges::data(v), std::ranges::size(v));
+    size_t n = values.size();
+    if (n == 0) throw std::runtime_error("Empty vector");
+    if (min_length == 0 || min_length > max_length || min_length > n) {
+        throw std::invalid_argument("Invalid subarray length bounds");
+    }
+    max_length = std::min(max_length, n);
+    std::vector<T> prefix(n + 1);
+    prefix[0] = (T) 0;
+    for (size_t i = 0; i < n; i++) {
+        prefix[i + 1] = prefix[i] + values[i];
+    }
+    // deque of starts stored in a vector, every start is pushed once
+    std::vector<size_t> starts(n + 1);
+    size_t head = 0, tail = 0;
+    size_t best_low = 0, best_high = min_length - 1;
+    T best = prefix[min_length];
+    for (size_t j = min_length; j <= n; j++) {
+        size_t start = j - min_length;
+        while (tail > head && prefix[starts[tail - 1]] >= prefix[start]) tail--;
+        starts[tail++] = start;
+        if (starts[head] + max_length < j) head++;
+        T sum = prefix[j] - prefix[starts[head]];
+        if (sum > best) {
+            best = sum;
+            best_low = starts[head];
+            best_high = j - 1;
+        }
+    }
+    return std::make_tuple(best_low, best_high, best);
+}
+
+/*
+ * Leaves at [leaves, 2 * leaves), node p covers the leaves of 2p and 2p + 1. The padding leaves 
+ * past n only reach nodes that no query uses
+ */
+template<Arithmetic T>
+MaxSubarrayTree<T>::MaxSubarrayTree(std::span<const T> values) : n(values.size()) {
+    while (leaves < n) leaves <<= 1;
+    nodes.assign(2 * leaves, single((T) 0, 0));
+    for (size_t i = 0; i < n; i++) {
+        nodes[leaves + i] = single(values[i], i);
+    }
+    for (size_t p = leaves - 1; p > 0; p--) {
+        nodes[p] = combine(nodes[2 * p], nodes[2 * p + 1]);
+    }
+}
+
+template<Arithmetic T>
+T MaxSubarrayTree<T>::at(size_t i) const {
+    if (i >= n) throw std::out_of_range("Index out of range");
+    return nodes[leaves + i].total;
+}
+
+template<Arithmetic T>
+void MaxSubarrayTree<T>::update(size_t i, T value) {
+    if (i >= n) throw std::out_of_range("Index out of range");
+    size_t p = leaves + i;
+    nodes[p] = single(value, i);
+    for (p >>= 1; p > 0; p >>= 1) {
+        nodes[p] = combine(nodes[2 * p], nodes[2 * p + 1]);
+    }
+}
+
+/*
+ * Bottom up walk, the nodes met from the left are combined in order on the left summary and the 
+ * ones met from the right on the right summary
+ */
+template<Arithmetic T>
+std::tuple<size_t, size_t, T> MaxSubarrayTree<T>::query(size_t l, size_t r) const {
+    if (l > r || r >= n) throw std::out_of_range("Index out of range");
+    max_subarray::Summary<T> left, right;
+    bool has_left = false, has_right = false;
+    for (l += leaves, r += leaves + 1; l < r; l >>= 1, r >>= 1) {
+        if (l & 1) {
+            left = has_left ? combine(left, nodes[l]) : nodes[l];
+            has_left = true;
+            l++;
+        }
+        if (r & 1) {
+            r--;
+            right = has_right ? combine(nodes[r], right) : nodes[r];
+            has_right = true;
+        }
+    }
+    if (!has_left) left = right;
+    else if (has_right) left = combine(left, right);
+    return std::make_tuple(left.best_low, left.best_high, left.best);
 }
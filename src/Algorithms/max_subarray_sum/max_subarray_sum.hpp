@@ -1,7 +1,7 @@
 /**
  * @file max_subarray_sum.hpp
  * @brief Maximum Subarray Sum Algorithms
- * @details Implementations for calculating the maximum subarray sum using \a std::vector.
+ * @details Implementations for calculating the maximum subarray sum over contiguous ranges.
  *          The implementation is valid for arithmetic types as defined by 
  *          \a std::is_arithmetic<>.
  * @author Atishek Kumar
@@ -15,37 +15,209 @@
 #include<vector>
 #include<tuple>
 #include<algorithm>
+#include<limits>
+#include<ranges>
+#include<span>
+#include<stdexcept>
+#include<memory>
 
 #include"../../Utils/arithmetic.hpp"
+#include"../../Utils/thread_pool.hpp"
+
+/**@namespace max_subarray
+ * @brief Maximum subarray sum constants
+ */
+namespace max_subarray {
+    /** @brief Minimum number of elements per chunk of max_subarray_sum_parallel()
+     */
+    const size_t PARALLEL_GRAIN = 1 << 16;
+    /** @brief Interleaved strips scanned together within a chunk
+     */
+    const int STRIPS = 4;
+
+    /**
+     * @brief Summary of a segment
+     * @details Summary of a segment A[low..high]: the total, the best prefix A[low..prefix_high], 
+     * the best suffix A[suffix_low..high] and the best subarray A[best_low..best_high]. The summary 
+     * of two adjacent segments follows from theirs, which is what max_subarray_sum_parallel() and 
+     * MaxSubarrayTree are built on.
+     * @tparam T Numerical data type of the values
+     */
+    template<Arithmetic T>
+    struct Summary {
+        T total;
+        T prefix;
+        size_t prefix_high;
+        T suffix;
+        size_t suffix_low;
+        T best;
+        size_t best_low, best_high;
+    };
+}
 
 /**
  * @brief Maximum Subarray Sum
  *
- * Function for finding the maximum subarray sum for the \a std::vector \a v. The function
+ * Function for finding the maximum subarray sum for the range \a v. The function
  * also computes the indices demarcating the required subarray. 
  *
+ * Divide and conquer over a view of the range, the best subarray lies in the left half, in the 
+ * right half or crosses the middle. With more than one thread the halves of at least 
+ * @ref max_subarray::PARALLEL_GRAIN elements are solved as parallel tasks.
+ *
  * \f$O(n \log n)\f$
  * 
- * @param v \a std::vector containing the array values
- * @tparam T Numerical data type of the \a std::vector elements
+ * @param v contiguous range containing the array values, e.g. a \a std::vector or a \a std::span
+ * @param threads number of threads, \a 0 uses all hardware threads
+ * @tparam Range Type of the range - Should be a contiguous range
+ * @tparam T Numerical data type of the range elements
  * @return tuple consisting of the starting, ending subarray indices and the maximum sum
+ * @exception std::runtime_error - When the range is empty
  */
-template <Arithmetic T>
-extern std::tuple<int, int, T> max_subarray_sum(std::vector<T> v);
+template<std::ranges::contiguous_range Range, Arithmetic T = std::ranges::range_value_t<Range>>
+extern std::tuple<size_t, size_t, T> max_subarray_sum(const Range &v, size_t threads = 1);
 
 /**
  * @brief Maximum Subarray Sum Fast
  *
  * A faster implementation of max_subarray_sum(). The function calculates only the
- * maximum sum and not the indices of the subarray. 
+ * maximum sum and not the indices of the subarray, with the single threaded 
+ * max_subarray_sum_parallel().
  *
  * \f$O(n)\f$
  *
  * @param v \a std::vector containing the array values
  * @tparam T data type of the \a std::vector elements
- * @return maximum sum value
+ * @return maximum sum value, \a std::numeric_limits<T>::lowest() for an empty \a std::vector
  */
 template <Arithmetic T>
-extern T max_subarray_sum_fast(std::vector<T> v);
+extern T max_subarray_sum_fast(const std::vector<T> &v);
+
+/**
+ * @brief Parallel Maximum Subarray Sum
+ *
+ * Kadane's algorithm in divide and combine form. Every chunk of the range is summarised by its 
+ * total, best prefix, best suffix and best subarray with their indices, and summaries of 
+ * adjacent chunks combine associatively:
+ * \f$best = \max(best_l, best_r, suffix_l + prefix_r)\f$. The chunks run in parallel on a 
+ * ThreadPool, within a chunk @ref max_subarray::STRIPS interleaved strips break the loop carried 
+ * dependency of the scan. Floating point sums may round differently with different chunking.
+ *
+ * \f$O(n / p)\f$ with \f$p\f$ threads
+ *
+ * @param v contiguous range containing the array values, e.g. a \a std::vector or a \a std::span
+ * @param threads number of threads, \a 0 uses all hardware threads
+ * @tparam Range Type of the range - Should be a contiguous range
+ * @tparam T Numerical data type of the range elements
+ * @return tuple consisting of the starting, ending subarray indices and the maximum sum
+ * @exception std::runtime_error - When the range is empty
+ */
+template<std::ranges::contiguous_range Range, Arithmetic T = std::ranges::range_value_t<Range>>
+extern std::tuple<size_t, size_t, T> max_subarray_sum_parallel(const Range &v, size_t threads = 0);
+
+/**
+ * @brief Maximum Sum Subrectangle
+ *
+ * Maximum sum subrectangle of a dense row major grid. Every pair of lines along the shorter side 
+ * of the grid compresses the lines between them into one array of sums along the longer side, 
+ * whose best subarray is found with the Kadane scan of max_subarray_sum_parallel(). The first 
+ * lines of the pairs are spread over the threads.
+ *
+ * \f$O(\min(r, c)^2 \max(r, c))\f$
+ *
+ * @param grid contiguous range containing the values row by row
+ * @param rows number of rows of the grid
+ * @param cols number of columns of the grid
+ * @param threads number of threads, \a 0 uses all hardware threads
+ * @tparam Range Type of the range - Should be a contiguous range
+ * @tparam T Numerical data type of the range elements
+ * @return tuple consisting of the top row, left column, bottom row and right column of the 
+ * subrectangle, all inclusive, and the maximum sum
+ * @exception std::runtime_error - When the grid is empty
+ * @exception std::invalid_argument - When the size of the range is not \a rows * \a cols
+ */
+template<std::ranges::contiguous_range Range, Arithmetic T = std::ranges::range_value_t<Range>>
+extern std::tuple<size_t, size_t, size_t, size_t, T> max_subrectangle_sum(const Range &grid, size_t rows, size_t cols, size_t threads = 0);
+
+/**
+ * @brief Length Bounded Maximum Subarray Sum
+ *
+ * Maximum sum subarray among those of \a min_length to \a max_length elements. The sum of 
+ * A[i..j - 1] is \f$P_j - P_i\f$ over the prefix sums, so for every end the best start is the 
+ * smallest prefix sum in the window \f$[j - max\_length, j - min\_length]\f$, kept in a 
+ * monotonic deque.
+ *
+ * \f$O(n)\f$
+ *
+ * @param v contiguous range containing the array values
+ * @param min_length minimum length of the subarray
+ * @param max_length maximum length of the subarray, longer than the range means no upper bound
+ * @tparam Range Type of the range - Should be a contiguous range
+ * @tparam T Numerical data type of the range elements
+ * @return tuple consisting of the starting, ending subarray indices and the maximum sum
+ * @exception std::runtime_error - When the range is empty
+ * @exception std::invalid_argument - When \a min_length is \a 0, greater than \a max_length 
+ * or greater than the size of the range
+ */
+template<std::ranges::contiguous_range Range, Arithmetic T = std::ranges::range_value_t<Range>>
+extern std::tuple<size_t, size_t, T> max_subarray_sum_bounded(const Range &v, size_t min_length, size_t max_length);
+
+/**
+ * @brief Maximum Subarray Segment Tree
+ * @details Segment tree over the values keeping the max_subarray::Summary of every node, so that 
+ * the maximum subarray of any range A[l..r] is combined from \f$O(\log n)\f$ nodes and a point 
+ * update refreshes the \f$O(\log n)\f$ nodes above it.
+ * @tparam T Numerical data type of the values
+ */
+template<Arithmetic T>
+class MaxSubarrayTree {
+    private:
+        std::vector<max_subarray::Summary<T>> nodes{};
+        size_t n = 0;
+        size_t leaves = 1;
+
+    public:
+        /**
+         * @brief Constructor
+         * @details Builds the tree in \f$O(n)\f$
+         * @param values initial values of the array
+         */
+        explicit MaxSubarrayTree(std::span<const T> values);
+
+        /**
+         * @brief Number of values
+         * @return \b size_t size of the array
+         */
+        size_t size() const noexcept {
+            return n;
+        }
+
+        /**
+         * @brief Value at an index
+         * @param i index of the value
+         * @return \b T value of A[i]
+         * @exception std::out_of_range - \a i not less than size()
+         */
+        T at(size_t i) const;
+
+        /**
+         * @brief Point update
+         * @details Sets A[i] to \a value in \f$O(\log n)\f$
+         * @param i index of the value
+         * @param value new value
+         * @exception std::out_of_range - \a i not less than size()
+         */
+        void update(size_t i, T value);
+
+        /**
+         * @brief Range query
+         * @details Maximum subarray of A[l..r] in \f$O(\log n)\f$
+         * @param l first index of the range
+         * @param r last index of the range, inclusive
+         * @return tuple consisting of the starting, ending subarray indices and the maximum sum
+         * @exception std::out_of_range - \a l greater than \a r or \a r not less than size()
+         */
+        std::tuple<size_t, size_t, T> query(size_t l, size_t r) const;
+};
 
 #endif //ALGORITHMS_MAX_SUBARRAY_SUM_HPP
@@ -1,73 +1,416 @@
 #include"order_statistics.hpp"
 
+#if defined(__GNUC__) && !defined(__clang__) && (defined(__x86_64__) || defined(__i386__))
+#define DSA_REDUCTION_SIMD
+#endif
+
 namespace {
+    /*
+     * Minimum (Min) and maximum (Max) of data[0..n), n > 0, with independent accumulators.
+     * NaNs never compare less or greater so they're skipped unless data[0] is one
+     */
+    template<SimdReducible T, bool Min, bool Max>
+        std::pair<T, T> minmaxScalar(const T *data, size_t n) {
+            constexpr int A = order_statistics::REDUCTION_ACCUMULATORS;
+            T lo[A], hi[A];
+            std::fill(lo, lo + A, data[0]);
+            std::fill(hi, hi + A, data[0]);
+            size_t i = 0;
+            for(; i + A <= n; i += A) {
+                for(int a = 0; a < A; a++) {
+                    if constexpr (Min) lo[a] = data[i + a] < lo[a] ? data[i + a] : lo[a];
+                    if constexpr (Max) hi[a] = data[i + a] > hi[a] ? data[i + a] : hi[a];
+                }
+            }
+            for(; i < n; i++) {
+                if constexpr (Min) lo[0] = data[i] < lo[0] ? data[i] : lo[0];
+                if constexpr (Max) hi[0] = data[i] > hi[0] ? data[i] : hi[0];
+            }
+            for(int a = 1; a < A; a++) {
+                if constexpr (Min) lo[0] = lo[a] < lo[0] ? lo[a] : lo[0];
+                if constexpr (Max) hi[0] = hi[a] > hi[0] ? hi[a] : hi[0];
+            }
+            return {lo[0], hi[0]};
+        }
+
+    /*
+     * First index of value in data[0..n), n when it isn't there
+     */
+    template<SimdReducible T>
+        size_t findScalar(const T *data, size_t n, T value) {
+            for(size_t i = 0; i < n; i++) {
+                if(data[i] == value) return i;
+            }
+            return n;
+        }
+
+#ifdef DSA_REDUCTION_SIMD
+    /*
+     * minmaxScalar() over Bytes wide registers, A registers per bound per iteration
+     */
+    template<SimdReducible T, bool Min, bool Max, int Bytes>
+        [[gnu::always_inline]] inline std::pair<T, T> minmaxSimd(const T *data, size_t n) {
+            typedef T V __attribute__((vector_size(Bytes)));
+            constexpr int L = Bytes / sizeof(T), A = order_statistics::REDUCTION_ACCUMULATORS;
+            if(n < (size_t) L * A) return minmaxScalar<T, Min, Max>(data, n);
+            V lo[A], hi[A];
+            for(int a = 0; a < A; a++) {
+                lo[a] = hi[a] = V{} + data[0];
+            }
+            size_t i = 0;
+            for(; i + L * A <= n; i += L * A) {
+                for(int a = 0; a < A; a++) {
+                    V x;
+                    std::memcpy(&x, data + i + a * L, sizeof(V));
+                    if constexpr (Min) lo[a] = x < lo[a] ? x : lo[a];
+                    if constexpr (Max) hi[a] = x > hi[a] ? x : hi[a];
+                }
+            }
+            for(int a = 1; a < A; a++) {
+                if constexpr (Min) lo[0] = lo[a] < lo[0] ? lo[a] : lo[0];
+                if constexpr (Max) hi[0] = hi[a] > hi[0] ? hi[a] : hi[0];
+            }
+            // the lanes and the tail
+            T lanes[2 * L];
+            std::memcpy(lanes, &lo[0], sizeof(V));
+            std::memcpy(lanes + L, &hi[0], sizeof(V));
+            std::pair<T, T> result{lanes[0], lanes[L]};
+            for(int l = 1; l < L; l++) {
+                if constexpr (Min) result.first = lanes[l] < result.first ? lanes[l] : result.first;
+                if constexpr (Max) result.second = lanes[L + l] > result.second ? lanes[L + l] : result.second;
+            }
+            for(; i < n; i++) {
+                if constexpr (Min) result.first = data[i] < result.first ? data[i] : result.first;
+                if constexpr (Max) result.second = data[i] > result.second ? data[i] : result.second;
+            }
+            return result;
+        }
+
+    /*
+     * findScalar() testing A registers per iteration
+     */
+    template<SimdReducible T, int Bytes>
+        [[gnu::always_inline]] inline size_t findSimd(const T *data, size_t n, T value) {
+            typedef T V __attribute__((vector_size(Bytes)));
+            constexpr int L = Bytes / sizeof(T), A = order_statistics::REDUCTION_ACCUMULATORS;
+            V target = V{} + value;
+            size_t i = 0;
+            for(; i + L * A <= n; i += L * A) {
+                V x;
+                std::memcpy(&x, data + i, sizeof(V));
+                auto hit = x == target;
+                for(int a = 1; a < A; a++) {
+                    std::memcpy(&x, data + i + a * L, sizeof(V));
+                    hit |= x == target;
+                }
+                uint64_t words[Bytes / 8];
+                std::memcpy(words, &hit, Bytes);
+                uint64_t any = 0;
+                for(int w = 0; w < Bytes / 8; w++) any |= words[w];
+                if(any) break;
+            }
+            return i + findScalar(data + i, n - i, value);
+        }
+
+    template<SimdReducible T, bool Min, bool Max>
+        __attribute__((target("avx2"))) std::pair<T, T> minmaxAvx2(const T *data, size_t n) {
+            return minmaxSimd<T, Min, Max, 32>(data, n);
+        }
+
+    template<SimdReducible T, bool Min, bool Max>
+        __attribute__((target("sse4.2"))) std::pair<T, T> minmaxSse4(const T *data, size_t n) {
+            return minmaxSimd<T, Min, Max, 16>(data, n);
+        }
+
+    template<SimdReducible T>
+        __attribute__((target("avx2"))) size_t findAvx2(const T *data, size_t n, T value) {
+            return findSimd<T, 32>(data, n, value);
+        }
+
+    template<SimdReducible T>
+        __attribute__((target("sse4.2"))) size_t findSse4(const T *data, size_t n, T value) {
+            return findSimd<T, 16>(data, n, value);
+        }
+#endif
+
+    /*
+     * Picks the widest reduction kernels supported by the CPU
+     */
+    template<SimdReducible T, bool Min, bool Max>
+        auto chooseMinmaxKernel() -> std::pair<T, T> (*)(const T *, size_t) {
+#ifdef DSA_REDUCTION_SIMD
+            __builtin_cpu_init();
+            if(__builtin_cpu_supports("avx2")) return minmaxAvx2<T, Min, Max>;
+            if(__builtin_cpu_supports("sse4.2")) return minmaxSse4<T, Min, Max>;
+#endif
+            return minmaxScalar<T, Min, Max>;
+        }
+
+    template<SimdReducible T>
+        auto chooseFindKernel() -> size_t (*)(const T *, size_t, T) {
+#ifdef DSA_REDUCTION_SIMD
+            __builtin_cpu_init();
+            if(__builtin_cpu_supports("avx2")) return findAvx2<T>;
+            if(__builtin_cpu_supports("sse4.2")) return findSse4<T>;
+#endif
+            return findScalar<T>;
+        }
+
+    /*
+     * Minimum and maximum of a non empty span, vectorised for SimdReducible types
+     */
+    template<Comparable T, bool Min, bool Max>
+        std::pair<T, T> reduce(std::span<const T> v) {
+            if(v.empty()) throw std::runtime_error("Empty vector");
+            if constexpr (SimdReducible<T>) {
+                static const auto kernel = chooseMinmaxKernel<T, Min, Max>();
+                return kernel(v.data(), v.size());
+            } else {
+                std::pair<T, T> minmax{v[0], v[0]};
+                for(const auto& val: v) {
+                    if(Min && val < minmax.first) minmax.first = val;
+                    if(Max && val > minmax.second) minmax.second = val;
+                }
+                return minmax;
+            }
+        }
+
+    /*
+     * First index of value in v, vectorised for SimdReducible types
+     */
     template<Comparable T>
-        T randomisedSelect(std::vector<T> v, int low, int high, int order) {
-            if(low == high) {
-                return v[low];
-            }
-            int pivot = randomisedPartition(v, sorting::increasingOrder<T> , low, high);
-            int index = pivot - low + 1;
-            if(index == order) {
-                return v[pivot];
-            } else if(order < index) {
-                return randomisedSelect(v, low, pivot - 1, order);
+        size_t indexOf(std::span<const T> v, const T &value) {
+            if(!(value == value)) return 0;
+            if constexpr (SimdReducible<T>) {
+                static const auto kernel = chooseFindKernel<T>();
+                return kernel(v.data(), v.size(), value);
             } else {
-                return randomisedSelect(v, pivot + 1, high, order - index);
+                return std::find(v.begin(), v.end(), value) - v.begin();
+            }
+        }
+    /*
+     * Moves the median of v[low], v[mid] and v[high] to v[high], the pivot of threeWayPartition()
+     */
+    template<Comparable T, Comparator<T> Compare>
+        void medianOfThreeToBack(std::vector<T> &v, Compare &compare, int low, int high) {
+            int mid = low + (high - low) / 2;
+            if(compare(v[low], v[mid])) std::swap(v[low], v[mid]);
+            if(compare(v[mid], v[high])) std::swap(v[mid], v[high]);
+            if(compare(v[low], v[mid])) std::swap(v[low], v[mid]);
+            std::swap(v[mid], v[high]);
+        }
+
+    /*
+     * Selects v[k] of v[low..high] with a heap of v[low..k] whose root comes last
+     */
+    template<Comparable T, Comparator<T> Compare>
+        void heapSelect(std::vector<T> &v, Compare &compare, int low, int high, int k) {
+            auto less = [&compare](const T &first, const T &second) { return compare(second, first); };
+            std::make_heap(v.begin() + low, v.begin() + k + 1, less);
+            for(int i = k + 1; i <= high; i++) {
+                if(compare(v[low], v[i])) {
+                    std::pop_heap(v.begin() + low, v.begin() + k + 1, less);
+                    std::swap(v[k], v[i]);
+                    std::push_heap(v.begin() + low, v.begin() + k + 1, less);
+                }
+            }
+            std::pop_heap(v.begin() + low, v.begin() + k + 1, less);
+        }
+
+    /*
+     * Selects v[k] of v[low..high] with median of medians pivots, worst case linear
+     */
+    template<Comparable T, Comparator<T> Compare>
+        void medianOfMediansSelect(std::vector<T> &v, Compare &compare, int low, int high, int k);
+
+    /*
+     * Index of the median of medians of groups of five of v[low..high], the group medians are 
+     * moved to the front of the range
+     */
+    template<Comparable T, Comparator<T> Compare>
+        int medianOfMedians(std::vector<T> &v, Compare &compare, int low, int high) {
+            int medians = 0;
+            for(int i = low; i <= high; i += 5) {
+                int end = std::min(i + 4, high);
+                introSort(v, compare, i, end);
+                std::swap(v[low + medians++], v[i + (end - i) / 2]);
             }
+            int mid = low + (medians - 1) / 2;
+            medianOfMediansSelect(v, compare, low, low + medians - 1, mid);
+            return mid;
+        }
+
+    template<Comparable T, Comparator<T> Compare>
+        void medianOfMediansSelect(std::vector<T> &v, Compare &compare, int low, int high, int k) {
+            while(high - low + 1 > sorting::INSERTION_SORT_THRESHOLD) {
+                std::swap(v[medianOfMedians(v, compare, low, high)], v[high]);
+                auto [lt, gt] = threeWayPartition(v, compare, low, high);
+                if(k < lt) {
+                    high = lt - 1;
+                } else if(k > gt) {
+                    low = gt + 1;
+                } else {
+                    return;
+                }
+            }
+            introSort(v, compare, low, high);
+        }
+
+    /*
+     * Introselect of v[k] in v[low..high]. Large ranges take the pivot of Floyd-Rivest: a sample 
+     * spread over the range is gathered around k and v[k] selected in it first, the sample range 
+     * is sized so that the pivot lands just past the k-th element. Small ranges take the median 
+     * of three. After INTROSELECT_STALL_LIMIT partitions in a row that keep more than three 
+     * quarters of the range the next pivot is a median of medians, which keeps at most 
+     * seven tenths, so the work stays linear
+     */
+    template<Comparable T, Comparator<T> Compare>
+        void introSelect(std::vector<T> &v, Compare &compare, int low, int high, int k) {
+            int stalls = 0;
+            while(high - low + 1 > sorting::INSERTION_SORT_THRESHOLD) {
+                int size = high - low + 1;
+                if(stalls == order_statistics::INTROSELECT_STALL_LIMIT) {
+                    std::swap(v[medianOfMedians(v, compare, low, high)], v[high]);
+                    stalls = 0;
+                } else if(size > order_statistics::FLOYD_RIVEST_THRESHOLD) {
+                    double n = size, i = k - low + 1;
+                    double z = std::log(n);
+                    double sample = 0.5 * std::exp(2 * z / 3);
+                    double deviation = 0.5 * std::sqrt(z * sample * (n - sample) / n) * (i < n / 2 ? -1 : 1);
+                    int sampleLow = std::max(low, (int) (k - i * sample / n + deviation));
+                    int sampleHigh = std::min(high, (int) (k + (n - i) * sample / n + deviation));
+                    int stride = size / (sampleHigh - sampleLow + 1);
+                    for(int j = sampleLow; j <= sampleHigh; j++) {
+                        std::swap(v[j], v[low + (j - sampleLow) * stride]);
+                    }
+                    introSelect(v, compare, sampleLow, sampleHigh, k);
+                    std::swap(v[k], v[high]);
+                } else {
+                    medianOfThreeToBack(v, compare, low, high);
+                }
+                auto [lt, gt] = threeWayPartition(v, compare, low, high);
+                if(k < lt) {
+                    high = lt - 1;
+                } else if(k > gt) {
+                    low = gt + 1;
+                } else {
+                    return;
+                }
+                stalls = high - low + 1 > size / 4 * 3 ? stalls + 1 : 0;
+            }
+            introSort(v, compare, low, high);
         }
 }
 
+template<std::ranges::contiguous_range Range, Comparable T>
+T maxVal(const Range &v) {
+    return reduce<T, false, true>(std::span<const T>(std::ranges::data(v), std::ranges::size(v))).second;
+}
+
+template<std::ranges::contiguous_range Range, Comparable T>
+T minVal(const Range &v) {
+    return reduce<T, true, false>(std::span<const T>(std::ranges::data(v), std::ranges::size(v))).first;
+}
+
+template<std::ranges::contiguous_range Range, Comparable T>
+std::pair<T, T> minmaxVal(const Range &v) {
+    return reduce<T, true, true>(std::span<const T>(std::ranges::data(v), std::ranges::size(v)));
+}
+
+template<std::ranges::contiguous_range Range, Comparable T>
+size_t argMax(const Range &v) {
+    std::span<const T> values(std::ranges::data(v), std::ranges::size(v));
+    return indexOf(values, reduce<T, false, true>(values).second);
+}
+
+template<std::ranges::contiguous_range Range, Comparable T>
+size_t argMin(const Range &v) {
+    std::span<const T> values(std::ranges::data(v), std::ranges::size(v));
+    return indexOf(values, reduce<T, true, false>(values).first);
+}
+
 template<Comparable T>
-T maxVal(std::vector<T> v) {
+T selectElement(std::vector<T> v, int order) {
     if(v.empty()) throw std::runtime_error("Empty vector");
-    T max = v[0];
-    for(const auto& val: v) {
-        if(val > max) {
-            max = val;
-        }
+    if(order > v.size() || order <= 0) throw std::out_of_range("Invalid order");
+    nthElement(v, order - 1);
+    return v[order - 1];
+}
+
+template<Comparable T, Comparator<T> Compare>
+void nthElement(std::vector<T> &v, int k, Compare compare) {
+    if(k < 0 || k >= (int) v.size()) throw std::out_of_range("Invalid index");
+    introSelect(v, compare, 0, (int) v.size() - 1, k);
+}
+
+template<Comparable T, Comparator<T> Compare>
+void partialSort(std::vector<T> &v, int k, Compare compare) {
+    if(k < 0 || k > (int) v.size()) throw std::out_of_range("Invalid number of elements");
+    if(k < 2) {
+        if(k == 1) nthElement(v, 0, compare);
+        return;
+    }
+    int n = (int) v.size();
+    if(k <= n / order_statistics::PARTIAL_SORT_HEAP_RATIO) {
+        // one pass against a heap of k values beats partitioning the whole vector
+        heapSelect(v, compare, 0, n - 1, k - 1);
+        introSort(v, compare, 0, k - 2);
+        return;
     }
-    return max;
+    if(k < n) nthElement(v, k - 1, compare);
+    introSort(v, compare, 0, k - 1);
 }
 
-template<Comparable T>
-T minVal(std::vector<T> v) {
-    if(v.empty()) throw std::runtime_error("Empty vector");
-    T min = v[0];
-    for(const auto& val: v){
-        if(val < min) {
-            min = val;
-        }
+template<Comparable T, Comparator<T> Compare>
+StreamingTopK<T, Compare>::StreamingTopK(int k, Compare compare) : k(k), compare(compare) {
+    if(k < 0) throw std::out_of_range("Invalid number of elements");
+    heap.reserve(k);
+}
+
+template<Comparable T, Comparator<T> Compare>
+void StreamingTopK<T, Compare>::push(const T &value) {
+    auto less = [this](const T &first, const T &second) { return before(first, second); };
+    if((int) heap.size() < k) {
+        heap.push_back(value);
+        std::push_heap(heap.begin(), heap.end(), less);
+    } else if(k > 0 && compare(heap.front(), value)) {
+        std::pop_heap(heap.begin(), heap.end(), less);
+        heap.back() = value;
+        std::push_heap(heap.begin(), heap.end(), less);
     }
-    return min;
 }
 
-template<Comparable T>
-std::pair<T, T> minmaxVal(std::vector<T> v) {
-    if(v.empty()) throw std::runtime_error("Empty vector");
-    std::pair<T, T> minmax;
-    int index = 0;
-    if(v.size() % 2 == 0) {
-        minmax = std::make_pair(v[v[0] >= v[1]], v[v[0] < v[1]]);
-        index = 2;
-    } else {
-        minmax = std::make_pair(v[0], v[0]);
-        index = 1;
-    } 
-    for(int i = index; i < v.size(); i += 2) {
-        T localMin = v[(v[i] >= v[i+1]) + i];
-        T localMax = v[(v[i] < v[i+1]) + i];
-        if(localMax > minmax.second) 
-            minmax.second = localMax;
-        if(localMin < minmax.first) 
-            minmax.first = localMin;
+template<Comparable T, Comparator<T> Compare>
+template<std::input_iterator It>
+void StreamingTopK<T, Compare>::push(It first, It last) {
+    for(; first != last; ++first) {
+        push(*first);
     }
-    return minmax;
 }
 
-template<Comparable T>
-T selectElement(std::vector<T> v, int order) {
-    if(v.empty()) throw std::runtime_error("Empty vector");
-    if(order > v.size() || order <= 0) throw std::out_of_range("Invalid order");
-    return randomisedSelect(v, 0, v.size()-1, order);
+template<Comparable T, Comparator<T> Compare>
+int StreamingTopK<T, Compare>::size() const {
+    return (int) heap.size();
+}
+
+template<Comparable T, Comparator<T> Compare>
+const T& StreamingTopK<T, Compare>::threshold() const {
+    if(heap.empty()) throw std::runtime_error("Empty top k");
+    return heap.front();
+}
+
+template<Comparable T, Comparator<T> Compare>
+std::vector<T> StreamingTopK<T, Compare>::sorted() const {
+    std::vector<T> values(heap);
+    if(values.size() > 1) introSort(values, compare, 0, (int) values.size() - 1);
+    return values;
+}
+
+template<std::ranges::input_range Range, Comparable T, Comparator<T> Compare>
+std::vector<T> topK(Range &&range, int k, Compare compare) {
+    StreamingTopK<T, Compare> top(k, compare);
+    for(const auto& value: range) {
+        top.push(value);
+    }
+    return top.sorted();
 }
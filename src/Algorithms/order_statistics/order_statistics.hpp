@@ -11,44 +11,118 @@
 #include<vector>
 #include<tuple>
 #include<stdexcept>
+#include<algorithm>
+#include<iterator>
+#include<ranges>
+#include<cmath>
+#include<span>
+#include<cstring>
+#include<cstdint>
 
 #include"../sorting/sorting.hpp"
 #include"../../Utils/comparable.hpp"
+#include"../../Utils/comparator.hpp"
+#include"../../Utils/arithmetic.hpp"
+
+/**@namespace order_statistics
+ * @brief Order statistics constants
+ */
+namespace order_statistics {
+    /** @brief partialSort() uses a bounded heap when \a k is at most \a n divided by this ratio
+     */
+    const int PARTIAL_SORT_HEAP_RATIO = 64;
+    /** @brief Ranges larger than this take Floyd-Rivest sampled pivots in nthElement()
+     */
+    const int FLOYD_RIVEST_THRESHOLD = 600;
+    /** @brief Unbalanced partitions in a row after which nthElement() takes a median of medians pivot
+     */
+    const int INTROSELECT_STALL_LIMIT = 2;
+    /** @brief Independent accumulators per bound of the min/max reductions
+     */
+    const int REDUCTION_ACCUMULATORS = 4;
+}
+
+/** @brief SIMD Reducible concept
+ * @details Arithmetic types reduced by maxVal(), minVal(), minmaxVal(), argMax() and argMin() 
+ * with vector registers
+ */
+template<typename T>
+concept SimdReducible = Arithmetic<T> && !std::same_as<T, bool> && !std::same_as<T, long double>;
 
 /** @brief Maximum Value
- * @details Get the \a maximum value in the \a std::vector
- * @param v \a std::vector containing the values
- * @tparam T Data type of the \a std::vector elements
- * @return Maximum value in the \a std::vector
- * @exception std::runtime_error - When the \a std::vector is empty  
+ * @details Get the \a maximum value of a contiguous range, e.g. a \a std::vector or a 
+ * \a std::span, without copying it. Arithmetic values are scanned with AVX2 or SSE4.2 registers 
+ * when the CPU supports them, with @ref order_statistics::REDUCTION_ACCUMULATORS independent 
+ * accumulators so that consecutive compares don't wait on each other.
+ *
+ * \f$O(n)\f$
+ * @param v contiguous range containing the values
+ * @tparam Range Type of the range - Should be a contiguous range
+ * @tparam T Data type of the range elements
+ * @return Maximum value in the range
+ * @exception std::runtime_error - When the range is empty  
  */
-template<Comparable T>
-T maxVal(std::vector<T> v);
+template<std::ranges::contiguous_range Range, Comparable T = std::ranges::range_value_t<Range>>
+T maxVal(const Range &v);
 
 /** @brief Minimum Value
- * @details Get the \a minimum value in the \a std::vector
- * @param v \a std::vector containing the values
- * @tparam T Data type of the \a std::vector elements
- * @return Mimimum value in the \a std::vector
- * @exception std::runtime_error - When the \a std::vector is empty  
+ * @details Get the \a minimum value of a contiguous range without copying it, see maxVal()
+ *
+ * \f$O(n)\f$
+ * @param v contiguous range containing the values
+ * @tparam Range Type of the range - Should be a contiguous range
+ * @tparam T Data type of the range elements
+ * @return Mimimum value in the range
+ * @exception std::runtime_error - When the range is empty  
  */
-template<Comparable T>
-T minVal(std::vector<T> v);
+template<std::ranges::contiguous_range Range, Comparable T = std::ranges::range_value_t<Range>>
+T minVal(const Range &v);
 
 /** @brief Maximum and Minimum Value
- * @details Get the \a maximum and \a minimum value in the \a std::vector
- * @param v \a std::vector containing the values
- * @tparam T Data type of the \a std::vector elements
+ * @details Get the \a maximum and \a minimum value of a contiguous range in one pass without 
+ * copying it, see maxVal()
+ *
+ * \f$O(n)\f$
+ * @param v contiguous range containing the values
+ * @tparam Range Type of the range - Should be a contiguous range
+ * @tparam T Data type of the range elements
  * @return std::pair containing the minimum and maximum values respectively
- * @exception std::runtime_error - When the \a std::vector is empty  
+ * @exception std::runtime_error - When the range is empty  
  */
-template<Comparable T>
-std::pair<T, T> minmaxVal(std::vector<T> v);
+template<std::ranges::contiguous_range Range, Comparable T = std::ranges::range_value_t<Range>>
+std::pair<T, T> minmaxVal(const Range &v);
+
+/** @brief Index of the Maximum Value
+ * @details Index of the first occurrence of maxVal(), found with a second vectorised scan
+ *
+ * \f$O(n)\f$
+ * @param v contiguous range containing the values
+ * @tparam Range Type of the range - Should be a contiguous range
+ * @tparam T Data type of the range elements
+ * @return \b size_t index of the maximum value
+ * @exception std::runtime_error - When the range is empty  
+ */
+template<std::ranges::contiguous_range Range, Comparable T = std::ranges::range_value_t<Range>>
+size_t argMax(const Range &v);
+
+/** @brief Index of the Minimum Value
+ * @details Index of the first occurrence of minVal(), found with a second vectorised scan
+ *
+ * \f$O(n)\f$
+ * @param v contiguous range containing the values
+ * @tparam Range Type of the range - Should be a contiguous range
+ * @tparam T Data type of the range elements
+ * @return \b size_t index of the minimum value
+ * @exception std::runtime_error - When the range is empty  
+ */
+template<std::ranges::contiguous_range Range, Comparable T = std::ranges::range_value_t<Range>>
+size_t argMin(const Range &v);
 
 /** @brief \a Order element's value
- * @details Get the value of the \a order element in the \a std::vector 
+ * @details Get the value of the \a order element in the \a std::vector, selected in place in 
+ * the copy of \a v with nthElement()
  * @param v \a std::vector containing the values
- * @param order of the element
+ * @param order of the element, starting at \a 1
  * @tparam T Data type of the \a std::vector elements
  * @return Maximum value in the \a std::vector
  * @exception std::runtime_error - When the \a std::vector is empty  
@@ -57,4 +131,126 @@ std::pair<T, T> minmaxVal(std::vector<T> v);
 template<Comparable T>
 T selectElement(std::vector<T> v, int order);
 
+/** @brief Nth Element
+ * @details Rearranges \a v in place so that \a v[k] is the element that would be there if \a v 
+ * was sorted, the elements before it don't come after it and the elements after it don't come 
+ * before it. Introselect with three-way partitions: ranges larger than 
+ * @ref order_statistics::FLOYD_RIVEST_THRESHOLD take the Floyd-Rivest pivot selected from a 
+ * sample spread over the range, smaller ones the median of three. After 
+ * @ref order_statistics::INTROSELECT_STALL_LIMIT partitions in a row keeping more than three 
+ * quarters of the range the next pivot is the median of medians of groups of five, which 
+ * bounds the work to linear. In place, no allocations.
+ *
+ * \f$O(n)\f$ worst case
+ * @param v \a std::vector containing the values
+ * @param k index of the element, starting at \a 0
+ * @param compare comparator callable defining the order
+ * @tparam T Data type of the \a std::vector elements
+ * @tparam Compare Type of the comparator - Should satisfy the Comparator concept
+ * @exception std::out_of_range - Invalid \a k value.
+ */
+template<Comparable T, Comparator<T> Compare = sorting::IncreasingOrder<T>>
+void nthElement(std::vector<T> &v, int k, Compare compare = Compare{});
+
+/** @brief Partial Sort
+ * @details Sorts the first \a k elements of the order of \a v in place into \a v[0..k), the 
+ * order of the rest is unspecified. For small \a k one pass keeps the first \a k elements in a 
+ * bounded heap, otherwise nthElement(), then introSort() of the first \a k elements.
+ *
+ * \f$O(n \log k)\f$ for small \a k, else \f$O(n + k \log k)\f$
+ * @param v \a std::vector containing the values
+ * @param k number of elements to be sorted
+ * @param compare comparator callable defining the order
+ * @tparam T Data type of the \a std::vector elements
+ * @tparam Compare Type of the comparator - Should satisfy the Comparator concept
+ * @exception std::out_of_range - Invalid \a k value.
+ */
+template<Comparable T, Comparator<T> Compare = sorting::IncreasingOrder<T>>
+void partialSort(std::vector<T> &v, int k, Compare compare = Compare{});
+
+/**
+ * @brief Streaming Top K
+ * @details Keeps the first \a k values of a stream in the order of \a Compare in a bounded 
+ * binary heap whose root is the kept value that comes last, so a value that doesn't make the 
+ * cut costs one comparison. With the default decreasing order these are the \a k largest values.
+ *
+ * push() is \f$O(\log k)\f$, \f$O(k)\f$ memory.
+ * @tparam T Data type of the values
+ * @tparam Compare Type of the comparator - Should satisfy the Comparator concept
+ */
+template<Comparable T, Comparator<T> Compare = sorting::DecreasingOrder<T>>
+class StreamingTopK {
+    private:
+        std::vector<T> heap{};
+        int k;
+        Compare compare;
+
+        /* root of the heap is the value coming last in the order */
+        bool before(const T &first, const T &second) {
+            return compare(second, first);
+        }
+
+    public:
+        /**
+         * @brief Constructor
+         * @param k number of values kept
+         * @param compare comparator callable defining the order
+         * @exception std::out_of_range - Negative \a k value.
+         */
+        explicit StreamingTopK(int k, Compare compare = Compare{});
+
+        /**
+         * @brief Add a value from the stream
+         * @param value next value of the stream
+         */
+        void push(const T &value);
+
+        /**
+         * @brief Add the values of an iterator range
+         * @param first iterator to the first value
+         * @param last end iterator
+         * @tparam It Type of the iterators - Should be an input iterator over \a T
+         */
+        template<std::input_iterator It>
+            void push(It first, It last);
+
+        /**
+         * @brief Number of values kept
+         * @return \b int at most \a k
+         */
+        int size() const;
+
+        /**
+         * @brief Value a new value has to come before to be kept
+         * @return \b const \b T& the kept value that comes last
+         * @exception std::runtime_error - When no value is kept
+         */
+        const T& threshold() const;
+
+        /**
+         * @brief Kept values in order
+         * @return \b std::vector<T> of the first \a size() values of the stream in order
+         */
+        std::vector<T> sorted() const;
+};
+
+/** @brief Top K
+ * @details First \a k values of \a range in the order of \a compare, the \a k largest with the 
+ * default decreasing order. Reads the range once through a StreamingTopK, the range isn't copied 
+ * or modified.
+ *
+ * \f$O(n \log k)\f$
+ * @param range input range containing the values
+ * @param k number of values
+ * @param compare comparator callable defining the order
+ * @tparam Range Type of the range - Should be an input range
+ * @tparam T Data type of the range values
+ * @tparam Compare Type of the comparator - Should satisfy the Comparator concept
+ * @return \b std::vector<T> of at most \a k values in order
+ * @exception std::out_of_range - Negative \a k value.
+ */
+template<std::ranges::input_range Range, Comparable T = std::ranges::range_value_t<Range>, 
+         Comparator<T> Compare = sorting::DecreasingOrder<T>>
+std::vector<T> topK(Range &&range, int k, Compare compare = Compare{});
+
 #endif //ALGORITHMS_ORDER_STATISTICS
@@ -0,0 +1,57 @@
+#include"./key_sorting.hpp"
+
+template<Comparable T, Comparator<T> Compare>
+std::vector<int> argsort(const std::vector<T> &v, Compare compare) {
+    if constexpr (RadixSortable<T> && std::same_as<Compare, sorting::IncreasingOrder<T>>) {
+        return lsdRadixArgsort(v, linear_sorting::INCREASING_ORDER);
+    } else if constexpr (RadixSortable<T> && std::same_as<Compare, sorting::DecreasingOrder<T>>) {
+        return lsdRadixArgsort(v, linear_sorting::DECREASING_ORDER);
+    } else {
+        std::vector<int> indices(v.size());
+        std::iota(indices.begin(), indices.end(), 0);
+        // ties broken by index so that equal keys keep their order
+        pdqSort(indices, [&v, &compare](int a, int b) {
+            return compare(v[a], v[b]) || (!compare(v[b], v[a]) && a > b);
+        });
+        return indices;
+    }
+}
+
+template<typename T>
+void applyPermutation(std::vector<T> &v, const std::vector<int> &permutation) {
+    if(permutation.size() != v.size()) {
+        throw std::invalid_argument("permutation and vector sizes don't match");
+    }
+    std::vector<T> sorted;
+    sorted.reserve(v.size());
+    for(int i: permutation) {
+        sorted.push_back(std::move(v[i]));
+    }
+    v.swap(sorted);
+}
+
+template<Comparable K, Comparator<K> Compare, typename... V>
+void sortByKey(std::vector<K> &keys, Compare compare, std::vector<V>&... values) {
+    if(((values.size() != keys.size()) || ...)) {
+        throw std::invalid_argument("keys and values sizes don't match");
+    }
+    std::vector<int> permutation = argsort(keys, compare);
+    applyPermutation(keys, permutation);
+    (applyPermutation(values, permutation), ...);
+}
+
+template<Comparable K, typename... V>
+void sortByKey(std::vector<K> &keys, std::vector<V>&... values) {
+    sortByKey(keys, sorting::IncreasingOrder<K>{}, values...);
+}
+
+template<typename T, typename Compare, typename Projection>
+    requires Comparable<ProjectedKey<T, Projection>> && Comparator<Compare, ProjectedKey<T, Projection>>
+void sortBy(std::vector<T> &v, Compare compare, Projection projection) {
+    std::vector<ProjectedKey<T, Projection>> keys;
+    keys.reserve(v.size());
+    for(const auto& record: v) {
+        keys.push_back(std::invoke(projection, record));
+    }
+    applyPermutation(v, argsort(keys, compare));
+}
@@ -0,0 +1,109 @@
+/**
+ * @file key_sorting.hpp
+ * @brief Key and Index Sorting
+ * @details Sorting through a permutation: the keys are sorted together with their indices and 
+ * the records are moved once, so sorting large records or parallel arrays costs one gather per 
+ * array instead of a swap of the whole record per step.
+ * @author Atishek Kumar
+ * @date May 2021
+ */
+#ifndef ALGORITHMS_KEY_SORTING_HPP
+#define ALGORITHMS_KEY_SORTING_HPP
+
+#include<vector>
+#include<concepts>
+#include<functional>
+#include<numeric>
+#include<stdexcept>
+#include<type_traits>
+
+#include"sorting.hpp"
+#include"linear_sorting.hpp"
+
+/** @brief Key type of a projection
+ * @details Type returned by \a Projection for a \a const reference of \a T, without reference 
+ * and cv qualifiers
+ */
+template<typename T, typename Projection>
+using ProjectedKey = std::remove_cvref_t<std::invoke_result_t<Projection&, const T&>>;
+
+/**
+ * @brief Argsort
+ *
+ * Stable permutation sorting \a v, \a v itself isn't modified. Integer and floating point keys 
+ * in increasing or decreasing order are sorted with lsdRadixArgsort(), otherwise the indices are 
+ * sorted with pdqSort() and ties broken by index.
+ *
+ * \f$O(n \log n)\f$
+ * @param v \a std::vector of keys
+ * @param compare comparator callable defining the sorted order
+ * @tparam T Data type of the \a std::vector elements - Should be comparable
+ * @tparam Compare Type of the comparator - Should satisfy the Comparator concept
+ * @return \b std::vector<int> indices of \a v in sorted order
+ */
+template<Comparable T, Comparator<T> Compare = sorting::IncreasingOrder<T>>
+extern std::vector<int> argsort(const std::vector<T> &v, Compare compare = Compare{});
+
+/**
+ * @brief Apply Permutation
+ *
+ * Rearranges \a v so that \a v[i] becomes the old \a v[permutation[i]], moving every element 
+ * once into a new buffer.
+ *
+ * \f$O(n)\f$
+ * @param v \a std::vector to be rearranged
+ * @param permutation permutation of the indices of \a v, as returned by argsort()
+ * @tparam T Data type of the \a std::vector elements
+ * @throws std::invalid_argument if the sizes don't match
+ */
+template<typename T>
+extern void applyPermutation(std::vector<T> &v, const std::vector<int> &permutation);
+
+/**
+ * @brief Sort By Key
+ *
+ * Stable sort of the parallel arrays \a keys and \a values by \a keys: argsort() of the keys 
+ * followed by one applyPermutation() per array.
+ *
+ * \f$O(n \log n)\f$
+ * @param keys \a std::vector of keys to be sorted in place
+ * @param compare comparator callable defining the sorted order
+ * @param values \a std::vector's of the same size rearranged with \a keys
+ * @tparam K Data type of the keys - Should be comparable
+ * @tparam Compare Type of the comparator - Should satisfy the Comparator concept
+ * @throws std::invalid_argument if the sizes don't match
+ */
+template<Comparable K, Comparator<K> Compare, typename... V>
+extern void sortByKey(std::vector<K> &keys, Compare compare, std::vector<V>&... values);
+
+/**
+ * @brief Sort By Key
+ *
+ * sortByKey() in increasing order of \a keys
+ * @param keys \a std::vector of keys to be sorted in place
+ * @param values \a std::vector's of the same size rearranged with \a keys
+ * @tparam K Data type of the keys - Should be comparable
+ * @throws std::invalid_argument if the sizes don't match
+ */
+template<Comparable K, typename... V>
+extern void sortByKey(std::vector<K> &keys, std::vector<V>&... values);
+
+/**
+ * @brief Sort By Projection
+ *
+ * Stable sort of \a v by the key \a projection(v[i]), e.g. a pointer to a data member. The keys 
+ * are extracted once and argsort()'ed, then the records are moved once by applyPermutation().
+ *
+ * \f$O(n \log n)\f$
+ * @param v \a std::vector of records to be sorted in place
+ * @param compare comparator callable over the keys defining the sorted order
+ * @param projection callable or member pointer giving the key of a record
+ * @tparam T Data type of the \a std::vector elements
+ * @tparam Compare Type of the comparator - Should satisfy the Comparator concept for the key type
+ * @tparam Projection Type of the projection
+ */
+template<typename T, typename Compare, typename Projection>
+    requires Comparable<ProjectedKey<T, Projection>> && Comparator<Compare, ProjectedKey<T, Projection>>
+extern void sortBy(std::vector<T> &v, Compare compare, Projection projection);
+
+#endif //ALGORITHMS_KEY_SORTING_HPP
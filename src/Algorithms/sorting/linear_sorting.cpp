@@ -2,6 +2,313 @@
 
 namespace {
 
+    /*
+     * Order preserving unsigned key of a RadixSortable value, values that compare equal get
+     * equal keys
+     */
+    template<RadixSortable T>
+        auto radixKey(T value) {
+            using U = std::make_unsigned_t<std::conditional_t<std::is_floating_point_v<T>,
+                  std::conditional_t<sizeof(T) == 4, int32_t, int64_t>, T>>;
+            constexpr U signBit = U(1) << (sizeof(U) * 8 - 1);
+            if constexpr (std::is_floating_point_v<T>) {
+                // -0.0 compares equal to 0.0, so it gets the same key and stays in input order
+                if(value == T(0)) value = T(0);
+                U bits = std::bit_cast<U>(value);
+                return (bits & signBit) ? U(~bits) : U(bits ^ signBit);
+            } else if constexpr (std::is_signed_v<T>) {
+                return U(U(value) ^ signBit);
+            } else {
+                return U(value);
+            }
+        }
+
+    /*
+     * Stable LSD passes over the RADIX_BITS wide digits of the Bytes low bytes of keyOf(element),
+     * histograms of every digit in one pass, skipping the digits shared by every key. When
+     * RADIX_BITS doesn't divide the key width the last digit is narrower
+     */
+    template<size_t Bytes, typename E, typename KeyOf>
+        void radixPasses(std::vector<E> &v, KeyOf keyOf) {
+            constexpr int bits = linear_sorting::RADIX_BITS;
+            constexpr int passes = (Bytes * 8 + bits - 1) / bits;
+            constexpr int buckets = 1 << bits;
+            constexpr int mask = buckets - 1;
+            constexpr int lastMask = (1 << (Bytes * 8 - (passes - 1) * bits)) - 1;
+            auto digit = [](auto key, int p) {
+                return (int) ((key >> (p * bits)) & (p == passes - 1 ? lastMask : mask));
+            };
+            size_t n = v.size();
+            if(n < 2) return;
+
+            std::vector<std::array<size_t, buckets>> count(passes);
+            for(const auto& element: v) {
+                auto key = keyOf(element);
+                for(int p = 0; p < passes; p++) {
+                    count[p][digit(key, p)]++;
+                }
+            }
+
+            std::vector<E> buffer(n);
+            std::vector<E> *src = &v, *dst = &buffer;
+            for(int p = 0; p < passes; p++) {
+                // every key has the same digit, the pass wouldn't move anything
+                if(count[p][digit(keyOf((*src)[0]), p)] == n) continue;
+                size_t offset[buckets];
+                size_t sum = 0;
+                for(int b = 0; b < buckets; b++) {
+                    offset[b] = sum;
+                    sum += count[p][b];
+                }
+                for(const auto& element: *src) {
+                    (*dst)[offset[digit(keyOf(element), p)]++] = element;
+                }
+                std::swap(src, dst);
+            }
+            if(src != &v) v.swap(buffer);
+        }
+
+    /*
+     * Distribution sort of v[low..high] into equal width buckets between the minimum and the
+     * maximum, scattered through the matching range of buffer with prefix sums of the bucket
+     * sizes. Buckets of more than NETWORK_SORT_THRESHOLD values are distributed again, up to
+     * BUCKET_SORT_MAX_DEPTH levels after which they're introsorted
+     */
+    template<std::floating_point T>
+        void bucketSortRecur(std::vector<T> &v, std::vector<T> &buffer, int low, int high, int depth) {
+            int size = high - low + 1;
+            // long double has no sorting network, its small buckets are insertion sorted
+            if(size <= sorting::INSERTION_SORT_THRESHOLD ||
+                    (!NetworkSortable<T> && size <= sorting::NETWORK_SORT_THRESHOLD)) {
+                for(int j = low + 1; j <= high; j++) {
+                    T key = v[j];
+                    int i = j - 1;
+                    while(i >= low && v[i] > key) {
+                        v[i + 1] = v[i];
+                        i--;
+                    }
+                    v[i + 1] = key;
+                }
+                return;
+            }
+            if constexpr (NetworkSortable<T>) {
+                if(size <= sorting::NETWORK_SORT_THRESHOLD) {
+                    networkSort(v, sorting::IncreasingOrder<T>{}, low, high);
+                    return;
+                }
+            }
+            if(depth == linear_sorting::BUCKET_SORT_MAX_DEPTH) {
+                introSort(v, sorting::IncreasingOrder<T>{}, low, high);
+                return;
+            }
+            auto [minimum, maximum] = std::minmax_element(v.begin() + low, v.begin() + high + 1);
+            T lowest = *minimum, highest = *maximum;
+            if(lowest == highest) return;
+            // halved so that the width of a range like [-max, max] doesn't overflow
+            int buckets = size / linear_sorting::BUCKET_SIZE + 1;
+            T scale = T(buckets) / (highest / 2 - lowest / 2);
+            if(!std::isfinite(scale)) {
+                // subnormal range
+                introSort(v, sorting::IncreasingOrder<T>{}, low, high);
+                return;
+            }
+            auto bucketOf = [lowest, scale, buckets](T value) {
+                T position = (value / 2 - lowest / 2) * scale;
+                return !(position >= 1) ? 0 : position >= buckets - 1 ? buckets - 1 : (int) position;
+            };
+
+            std::vector<int> count(buckets + 1, 0);
+            for(int i = low; i <= high; i++) {
+                count[bucketOf(v[i]) + 1]++;
+            }
+            for(int b = 0; b < buckets; b++) {
+                count[b + 1] += count[b];
+            }
+            for(int i = low; i <= high; i++) {
+                buffer[low + count[bucketOf(v[i])]++] = v[i];
+            }
+            std::copy(buffer.begin() + low, buffer.begin() + high + 1, v.begin() + low);
+            // count[b] is now the end of bucket b
+            for(int b = 0, start = 0; b < buckets; start = count[b++]) {
+                if(count[b] - start > 1) {
+                    bucketSortRecur(v, buffer, low + start, low + count[b] - 1, depth + 1);
+                }
+            }
+        }
+
+    /*
+     * Offset of key from minimum, wraps around for keys below minimum
+     */
+    template<std::integral K>
+        inline size_t keyOffset(K key, K minimum) {
+            using U = std::make_unsigned_t<K>;
+            return (size_t) U(U(key) - U(minimum));
+        }
+
+    /*
+     * Number of keys in [minimum, maximum]
+     */
+    template<std::integral K>
+        size_t countingRange(K minimum, K maximum) {
+            if(maximum < minimum) {
+                throw std::invalid_argument("maximum is less than minimum");
+            }
+            size_t range = keyOffset(maximum, minimum);
+            if(range >= linear_sorting::COUNTING_SORT_MAX_RANGE) {
+                throw std::invalid_argument("key range is too large for counting sort");
+            }
+            return range + 1;
+        }
+
+    /*
+     * Number of contiguous parts of n elements counted by separate threads
+     */
+    inline size_t countingParts(size_t n, size_t threads) {
+        if(threads == 0) threads = std::thread::hardware_concurrency();
+        return std::max<size_t>(1, std::min(threads, n / linear_sorting::COUNTING_SORT_GRAIN));
+    }
+
+    /*
+     * Runs part(t, begin, end) on the parts contiguous parts of [0, n), in parallel when there's a pool
+     */
+    template<typename Part>
+        void forEachPart(ThreadPool *pool, size_t n, size_t parts, Part part) {
+            if(pool == nullptr) {
+                part(0, 0, n);
+                return;
+            }
+            TaskGroup group(*pool);
+            for(size_t t = 0; t < parts; t++) {
+                group.run([&part, t, n, parts]() { part(t, n * t / parts, n * (t + 1) / parts); });
+            }
+            group.wait();
+        }
+
+    /*
+     * Histogram of the keys of every part of v in counts[t * range .. (t + 1) * range)
+     */
+    template<typename E, typename KeyOf, std::integral K>
+        void countingHistograms(ThreadPool *pool, const std::vector<E> &v, KeyOf keyOf, K minimum, size_t range,
+                                size_t parts, std::vector<size_t> &counts) {
+            std::vector<char> outside(parts, 0);
+            forEachPart(pool, v.size(), parts, [&](size_t t, size_t begin, size_t end) {
+                size_t *count = counts.data() + t * range;
+                for(size_t i = begin; i < end; i++) {
+                    size_t k = keyOffset(K(keyOf(v[i])), minimum);
+                    if(k >= range) {
+                        outside[t] = 1;
+                        return;
+                    }
+                    count[k]++;
+                }
+            });
+            if(std::find(outside.begin(), outside.end(), 1) != outside.end()) {
+                throw std::invalid_argument("key outside of [minimum, maximum]");
+            }
+        }
+
+    /*
+     * Character of s at depth d as an unsigned value, -1 past the end of the string
+     */
+    template<StringKey T>
+        inline int charAt(const T &s, size_t d) {
+            return d < s.size() ? (unsigned char) s[d] : -1;
+        }
+
+    /*
+     * Insertion sort of v[low..high] whose strings share their first d characters
+     */
+    template<StringKey T>
+        void stringInsertionSort(std::vector<T> &v, int low, int high, size_t d) {
+            for(int j = low + 1; j <= high; j++) {
+                T key = std::move(v[j]);
+                std::string_view keySuffix = std::string_view(key).substr(std::min(d, key.size()));
+                int i = j - 1;
+                while(i >= low && std::string_view(v[i]).substr(std::min(d, v[i].size())) > keySuffix) {
+                    v[i + 1] = std::move(v[i]);
+                    i--;
+                }
+                v[i + 1] = std::move(key);
+            }
+        }
+
+    /*
+     * Multikey quick sort of v[low..high] whose strings share their first d characters,
+     * three-way partition on the character at depth d
+     */
+    template<StringKey T>
+        void multikeyQuickSort(std::vector<T> &v, int low, int high, size_t d) {
+            while(high - low + 1 >= linear_sorting::STRING_INSERTION_SORT_THRESHOLD) {
+                int mid = low + (high - low) / 2;
+                int a = charAt(v[low], d), b = charAt(v[mid], d), c = charAt(v[high], d);
+                int pivot = std::max(std::min(a, b), std::min(std::max(a, b), c));
+                int lt = low, i = low, gt = high;
+                while(i <= gt) {
+                    int ch = charAt(v[i], d);
+                    if(ch < pivot) std::swap(v[lt++], v[i++]);
+                    else if(ch > pivot) std::swap(v[i], v[gt--]);
+                    else i++;
+                }
+                multikeyQuickSort(v, low, lt - 1, d);
+                if(pivot >= 0) multikeyQuickSort(v, lt, gt, d + 1);
+                low = gt + 1;
+            }
+            stringInsertionSort(v, low, high, d);
+        }
+
+    /*
+     * One MSD radix pass over v[low..high] whose strings share their first d characters,
+     * distributing through the matching ranges of buffer and chars. Characters shared by every
+     * string are skipped first. Bucket 0 holds the strings that ended, onBucket(low, high, d) is
+     * called for every other bucket of more than one string with the depth of its next character.
+     * The bucket of every string is cached in chars so that each pass reads the strings once
+     */
+    template<StringKey T, typename OnBucket>
+        void msdRadixDistribute(std::vector<T> &v, std::vector<T> &buffer, std::vector<uint16_t> &chars,
+                                int low, int high, size_t d, OnBucket onBucket) {
+            int count[258];
+            while(true) {
+                std::fill(count, count + 258, 0);
+                for(int i = low; i <= high; i++) {
+                    chars[i] = (uint16_t) (charAt(v[i], d) + 1);
+                    count[chars[i] + 1]++;
+                }
+                // shared prefix, every string in one bucket so nothing moves
+                int single = chars[low] + 1;
+                if(count[single] != high - low + 1) break;
+                if(single == 1) return;
+                d++;
+            }
+            for(int b = 0; b < 257; b++) {
+                count[b + 1] += count[b];
+            }
+            for(int i = low; i <= high; i++) {
+                buffer[low + count[chars[i]]++] = std::move(v[i]);
+            }
+            std::move(buffer.begin() + low, buffer.begin() + high + 1, v.begin() + low);
+            // count[b] is now the end of bucket b, bucket 0 holds the strings that ended
+            for(int b = 0; b < 256; b++) {
+                if(count[b + 1] - count[b] > 1) {
+                    onBucket(low + count[b], low + count[b + 1] - 1, d + 1);
+                }
+            }
+        }
+
+    /*
+     * MSD radix sort of v[low..high] whose strings share their first d characters
+     */
+    template<StringKey T>
+        void msdRadixSortRecur(std::vector<T> &v, std::vector<T> &buffer, std::vector<uint16_t> &chars,
+                               int low, int high, size_t d) {
+            if(high - low + 1 < linear_sorting::MULTIKEY_QUICKSORT_THRESHOLD) {
+                multikeyQuickSort(v, low, high, d);
+                return;
+            }
+            msdRadixDistribute(v, buffer, chars, low, high, d, [&](int bucketLow, int bucketHigh, size_t depth) {
+                msdRadixSortRecur(v, buffer, chars, bucketLow, bucketHigh, depth);
+            });
+        }
+
     template<std::integral T>
         std::vector<T> crSort(std::vector<T> v, long long m ,int maximum, int compareFlag) {
             std::vector<T> count;
@@ -33,26 +340,71 @@ namespace {
 
 template<std::integral T>
 std::vector<T> countingSort(std::vector<T> v, T maximum, int compareFlag) {
-    std::vector<T> count;
-    for(T i = 0; i <= maximum; i++) {
-        count.push_back(0);
-    }
-    for(T i = 0; i < v.size(); i++) {
-        count[v[i]]++;
+    rangeCountingSort(v, T(0), maximum, compareFlag);
+    return v;
+}
+
+template<std::integral T>
+void rangeCountingSort(std::vector<T> &v, T minimum, T maximum, int compareFlag, size_t threads) {
+    using U = std::make_unsigned_t<T>;
+    size_t range = countingRange(minimum, maximum), n = v.size();
+    size_t parts = countingParts(n, threads);
+    auto pool = parts > 1 ? std::make_unique<ThreadPool>(parts) : nullptr;
+    std::vector<size_t> counts(parts * range);
+    countingHistograms(pool.get(), v, [](T value) { return value; }, minimum, range, parts, counts);
+
+    // merged histogram in sorted order, then the start of every value
+    for(size_t t = 1; t < parts; t++) {
+        for(size_t k = 0; k < range; k++) {
+            counts[k] += counts[t * range + k];
+        }
     }
-    if(compareFlag == linear_sorting::INCREASING_ORDER) {
-        for(T i = 1; i <= maximum; i++)
-            count[i] += count[i-1];
-    } else if(compareFlag == linear_sorting::DECREASING_ORDER) {
-        for(T i = maximum-1; i >= 0; i--) 
-            count[i] += count[i+1];
+    if(compareFlag == linear_sorting::DECREASING_ORDER) {
+        std::reverse(counts.begin(), counts.begin() + range);
     }
-    std::vector<T> output(v.size());
-    for(T i = v.size() - 1; i >= 0; i--) {
-        output[count[v[i]]-1] = v[i];
-        count[v[i]]--;
+    std::exclusive_scan(counts.begin(), counts.begin() + range, counts.begin(), size_t(0));
+    auto valueOf = [minimum, range, compareFlag](size_t j) {
+        size_t k = compareFlag == linear_sorting::DECREASING_ORDER ? range - 1 - j : j;
+        return T(U(U(minimum) + U(k)));
+    };
+    forEachPart(pool.get(), n, parts, [&](size_t, size_t begin, size_t end) {
+        size_t j = std::upper_bound(counts.begin(), counts.begin() + range, begin) - counts.begin() - 1;
+        for(size_t i = begin; i < end; j++) {
+            size_t stop = std::min(end, j + 1 < range ? counts[j + 1] : n);
+            std::fill(v.begin() + i, v.begin() + stop, valueOf(j));
+            i = stop;
+        }
+    });
+}
+
+template<typename R, std::integral K, typename KeyOf>
+    requires std::convertible_to<std::invoke_result_t<KeyOf&, const R&>, K>
+void countingSortByKey(std::vector<R> &v, KeyOf key, K minimum, K maximum, int compareFlag, size_t threads) {
+    size_t range = countingRange(minimum, maximum), n = v.size();
+    size_t parts = countingParts(n, threads);
+    auto pool = parts > 1 ? std::make_unique<ThreadPool>(parts) : nullptr;
+    std::vector<size_t> counts(parts * range);
+    auto keyOf = [&key](const R &record) { return K(std::invoke(key, record)); };
+    countingHistograms(pool.get(), v, keyOf, minimum, range, parts, counts);
+
+    // counts[t * range + k] becomes the output position of the first key k of part t
+    size_t sum = 0;
+    for(size_t j = 0; j < range; j++) {
+        size_t k = compareFlag == linear_sorting::DECREASING_ORDER ? range - 1 - j : j;
+        for(size_t t = 0; t < parts; t++) {
+            size_t count = counts[t * range + k];
+            counts[t * range + k] = sum;
+            sum += count;
+        }
     }
-    return output;
+    std::vector<R> output(n);
+    forEachPart(pool.get(), n, parts, [&](size_t t, size_t begin, size_t end) {
+        size_t *offset = counts.data() + t * range;
+        for(size_t i = begin; i < end; i++) {
+            output[offset[keyOffset(keyOf(v[i]), minimum)]++] = std::move(v[i]);
+        }
+    });
+    v.swap(output);
 }
 
 template<std::integral T>
@@ -68,39 +420,95 @@ std::vector<T> radixSort(std::vector<T> v, int digits, int maximum ,int compareF
 
 template<std::floating_point T>
 void normalise(std::vector<T> &v, std::function<T(T)> compute) {
-    return;
+    if(compute) {
+        for(auto& value: v) {
+            value = compute(value);
+        }
+        return;
+    }
+    if(v.empty()) return;
+    auto [minimum, maximum] = std::minmax_element(v.begin(), v.end());
+    T low = *minimum, range = *maximum - *minimum;
+    for(auto& value: v) {
+        // the largest value maps just below 1
+        value = range > 0 ? std::min((value - low) / range, std::nextafter(T(1), T(0))) : T(0);
+    }
 }
 
 template<std::floating_point T>
 std::vector<T> bucketSort(std::vector<T> v, int compareFlag) {
-    std::vector<std::vector<T>> buckets(v.size());
-    std::vector<T> out;
-    auto n = v.size();
-    for(int i = 0; i < v.size(); i++) {
-        int index = std::floor(n*v[i]);
-        buckets[index].push_back(v[i]);
+    // infinities to the ends and NaNs last, the buckets span the finite values
+    auto numbers = std::partition(v.begin(), v.end(), [](T value) { return !std::isnan(value); });
+    auto finite = std::partition(v.begin(), numbers, [](T value) { return value == -std::numeric_limits<T>::infinity(); });
+    auto infinite = std::partition(finite, numbers, [](T value) { return value != std::numeric_limits<T>::infinity(); });
+    int low = (int) (finite - v.begin()), high = (int) (infinite - v.begin()) - 1;
+    std::vector<T> buffer(v.size());
+    bucketSortRecur(v, buffer, low, high, 0);
+    if(compareFlag == linear_sorting::DECREASING_ORDER) {
+        std::reverse(v.begin(), numbers);
     }
-    if(compareFlag == linear_sorting::INCREASING_ORDER){
-        for(int i = 0; i < v.size(); i++) {
-            insertionSort(buckets[i]);
-        }
-        for(auto b: buckets) {
-            if(b.empty()) continue;
-            for(auto val: b) {
-                out.push_back(val);
-            }
-        }
+    return v;
+}
+
+template<RadixSortable T>
+void lsdRadixSort(std::vector<T> &v, int compareFlag) {
+    using Key = decltype(radixKey(T()));
+    const Key flip = compareFlag == linear_sorting::DECREASING_ORDER ? Key(~Key(0)) : Key(0);
+    radixPasses<sizeof(T)>(v, [flip](const T &value) { return radixKey(value) ^ flip; });
+}
+
+template<RadixSortable T>
+std::vector<int> lsdRadixArgsort(const std::vector<T> &v, int compareFlag) {
+    using Key = decltype(radixKey(T()));
+    const Key flip = compareFlag == linear_sorting::DECREASING_ORDER ? Key(~Key(0)) : Key(0);
+    std::vector<std::pair<Key, int>> keys(v.size());
+    for(int i = 0; i < (int) v.size(); i++) {
+        keys[i] = {radixKey(v[i]) ^ flip, i};
     }
-    else if(compareFlag == linear_sorting::DECREASING_ORDER) {
-        for(int i = 0; i < v.size(); i++) {
-            insertionSort(buckets[i], sorting::decreasingOrder<T>);
+    radixPasses<sizeof(T)>(keys, [](const std::pair<Key, int> &key) { return key.first; });
+    std::vector<int> indices(v.size());
+    for(int i = 0; i < (int) v.size(); i++) {
+        indices[i] = keys[i].second;
+    }
+    return indices;
+}
+
+template<StringKey T>
+void msdRadixSort(std::vector<T> &v, int compareFlag, size_t threads) {
+    int n = (int) v.size();
+    if(threads == 0) threads = std::thread::hardware_concurrency();
+    std::vector<T> buffer(n);
+    std::vector<uint16_t> chars(n);
+    if(threads <= 1 || n < linear_sorting::MULTIKEY_QUICKSORT_THRESHOLD) {
+        msdRadixSortRecur(v, buffer, chars, 0, n - 1, 0);
+    } else {
+        // split the largest bucket until there is one per thread, so that keys sharing a prefix
+        // such as URLs and paths still spread over the threads, then sort the buckets in parallel
+        std::vector<std::tuple<int, int, size_t>> buckets{{0, n - 1, 0}};
+        auto size = [](const std::tuple<int, int, size_t> &bucket) {
+            return std::get<1>(bucket) - std::get<0>(bucket) + 1;
+        };
+        while(!buckets.empty() && buckets.size() < threads) {
+            auto largest = std::max_element(buckets.begin(), buckets.end(), [&](const auto &a, const auto &b) {
+                return size(a) < size(b);
+            });
+            if(size(*largest) < linear_sorting::MULTIKEY_QUICKSORT_THRESHOLD) break;
+            auto [low, high, d] = *largest;
+            buckets.erase(largest);
+            msdRadixDistribute(v, buffer, chars, low, high, d, [&](int bucketLow, int bucketHigh, size_t depth) {
+                buckets.emplace_back(bucketLow, bucketHigh, depth);
+            });
         }
-        for(int i = buckets.size() - 1; i >= 0; i--) {
-            if(buckets[i].empty()) continue;
-            for(auto val: buckets[i]){
-                out.push_back(val);
-            }
+        ThreadPool pool(threads);
+        TaskGroup group(pool);
+        for(auto [low, high, d]: buckets) {
+            group.run([&v, &buffer, &chars, low, high, d]() {
+                msdRadixSortRecur(v, buffer, chars, low, high, d);
+            });
         }
+        group.wait();
+    }
+    if(compareFlag == linear_sorting::DECREASING_ORDER) {
+        std::reverse(v.begin(), v.end());
     }
-    return out;
 }
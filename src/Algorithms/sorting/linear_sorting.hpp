@@ -11,8 +11,25 @@
 
 #include<vector>
 #include<concepts>
+#include<array>
+#include<bit>
+#include<cstdint>
+#include<limits>
+#include<type_traits>
+#include<string>
+#include<string_view>
+#include<tuple>
+#include<algorithm>
+#include<utility>
+#include<cmath>
+#include<functional>
+#include<memory>
+#include<numeric>
+#include<stdexcept>
 
 #include"sorting.hpp"
+#include"sorting_network.hpp"
+#include"../../Utils/thread_pool.hpp"
 
 /**@namespace linear_sorting
  * @details Constant flags for determining the sorting sequence for the algorithm
@@ -24,11 +41,42 @@ namespace linear_sorting{
     /** @brief Sorting in  decreasing order 
      */
     const int DECREASING_ORDER = 1;
+    /** @brief Number of key bits sorted per pass by lsdRadixSort()
+     */
+    const int RADIX_BITS = 8;
+    /** @brief Buckets smaller than this are sorted by msdRadixSort() with multikey quick sort
+     */
+    const int MULTIKEY_QUICKSORT_THRESHOLD = 64;
+    /** @brief Subarrays smaller than this are sorted by the multikey quick sort with insertion sort
+     */
+    const int STRING_INSERTION_SORT_THRESHOLD = 10;
+    /** @brief Average number of values per bucket of bucketSort()
+     */
+    const int BUCKET_SIZE = 8;
+    /** @brief Levels of redistribution of large buckets by bucketSort() before falling back to introSort()
+     */
+    const int BUCKET_SORT_MAX_DEPTH = 4;
+    /** @brief Minimum number of elements counted per thread by rangeCountingSort() and countingSortByKey()
+     */
+    const size_t COUNTING_SORT_GRAIN = 1 << 16;
+    /** @brief Largest key range of rangeCountingSort() and countingSortByKey()
+     */
+    const size_t COUNTING_SORT_MAX_RANGE = size_t(1) << 28;
 }
 
+/** @brief Radix Sortable concept
+ * @details Integers (except \a bool) and IEEE 754 single and double precision floating point
+ * values, the types lsdRadixSort() can map to order preserving unsigned keys.
+ */
+template<typename T>
+concept RadixSortable = (std::integral<T> && !std::same_as<T, bool>) ||
+    (std::floating_point<T> && std::numeric_limits<T>::is_iec559 && (sizeof(T) == 4 || sizeof(T) == 8));
+
 /**@brief Counting Sort Algorithm
  * @details Sorting Integer values in the range 0 to \a maximum. Increasing order by default.
  *
+ * Also see rangeCountingSort()
+ *
  * \f$O(n)\f$
  * @param v \a std::vector of integral values to be sorted
  * @param maximum maximum value of the element in \a v
@@ -39,6 +87,47 @@ namespace linear_sorting{
 template<std::integral T>
 extern std::vector<T> countingSort(std::vector<T> v, T maximum , int compareFlag = linear_sorting::INCREASING_ORDER);
 
+/**@brief Counting Sort Algorithm over a key range
+ * @details Sorts integer values in \f$[minimum, maximum]\f$ in place. The histogram of all the 
+ * threads is allocated once, every thread counts a contiguous part of \a v, then the histograms 
+ * are merged with a prefix sum and the threads write the sorted values back in parallel.
+ *
+ * \f$O(n + k)\f$ where \f$k\f$ is the size of the range
+ * @param v \a std::vector of integral values to be sorted in place
+ * @param minimum smallest value of the range
+ * @param maximum largest value of the range
+ * @param compareFlag @ref linear_sorting constant defining sorted order
+ * @param threads number of threads, \a 0 uses all hardware threads
+ * @tparam T Data type of the \a std::vector elements - Should be Integral
+ * @throws std::invalid_argument if a value is outside of the range or the range is larger than 
+ * @ref linear_sorting::COUNTING_SORT_MAX_RANGE
+ */
+template<std::integral T>
+extern void rangeCountingSort(std::vector<T> &v, T minimum, T maximum, 
+                              int compareFlag = linear_sorting::INCREASING_ORDER, size_t threads = 1);
+
+/**@brief Counting Sort By Key
+ * @details Stable sort of records by an integer key in \f$[minimum, maximum]\f$. Every thread 
+ * counts the keys of a contiguous part of \a v, the prefix sum over keys and parts gives every 
+ * part its own output positions so the parts are scattered in parallel and stay stable.
+ *
+ * \f$O(n + k)\f$ where \f$k\f$ is the size of the range
+ * @param v \a std::vector of records to be sorted in place
+ * @param key callable or member pointer giving the key of a record
+ * @param minimum smallest key of the range
+ * @param maximum largest key of the range
+ * @param compareFlag @ref linear_sorting constant defining sorted order
+ * @param threads number of threads, \a 0 uses all hardware threads
+ * @tparam R Data type of the records - Should be default constructible
+ * @tparam K Data type of the keys - Should be Integral
+ * @throws std::invalid_argument if a key is outside of the range or the range is larger than 
+ * @ref linear_sorting::COUNTING_SORT_MAX_RANGE
+ */
+template<typename R, std::integral K, typename KeyOf>
+    requires std::convertible_to<std::invoke_result_t<KeyOf&, const R&>, K>
+extern void countingSortByKey(std::vector<R> &v, KeyOf key, K minimum, K maximum, 
+                              int compareFlag = linear_sorting::INCREASING_ORDER, size_t threads = 1);
+
 /**@brief Radix Sort Algorithm
  * @details Recusively sort the elements using the least significant to the most significant 
  * digit using a variation of countingSort()
@@ -54,28 +143,87 @@ extern std::vector<T> countingSort(std::vector<T> v, T maximum , int compareFlag
 template<std::integral T>
 extern std::vector<T> radixSort(std::vector<T> v, int digit, int maximum = 9, int compareFlag = linear_sorting::INCREASING_ORDER);
 
-/** @brief Normalise the \a std::vector for bucketSort()
- * @details Normalises the value in the vector to the range \f$[0,1)\f$
+/**@brief LSD Radix Sort Algorithm
+ * @details Sorts the full range of integer and floating point values one byte at a time, from the 
+ * least to the most significant byte. Each value is mapped to an unsigned key that orders the 
+ * same way: the sign bit is flipped for signed integers, and for floating point values the sign 
+ * bit of positive values and all bits of negative values are flipped, so negative numbers and 
+ * infinities order correctly (NaNs go to the ends). \f$-0.0\f$ and \f$0.0\f$ compare equal, they 
+ * get the same key and keep their input order.
+ *
+ * The histograms of every byte are built in a single pass, passes where all the keys share the 
+ * same byte are skipped and the passes ping-pong between \a v and one buffer. Stable.
  *
- * Should be called before calling bucketSort().
+ * \f$O(n \cdot sizeof(T))\f$
+ * @param v \a std::vector of values to be sorted in place
+ * @param compareFlag @ref linear_sorting constant defining sorted order
+ * @tparam T Data type of the \a std::vector elements - Should be RadixSortable
+ */
+template<RadixSortable T>
+extern void lsdRadixSort(std::vector<T> &v, int compareFlag = linear_sorting::INCREASING_ORDER);
+
+/**@brief LSD Radix Argsort
+ * @details Stable permutation sorting \a v with the passes of lsdRadixSort() over (key, index) 
+ * pairs, \a v itself isn't moved.
+ *
+ * \f$O(n \cdot sizeof(T))\f$
+ * @param v \a std::vector of values
+ * @param compareFlag @ref linear_sorting constant defining sorted order
+ * @tparam T Data type of the \a std::vector elements - Should be RadixSortable
+ * @return \b std::vector<int> indices of \a v in sorted order
+ */
+template<RadixSortable T>
+extern std::vector<int> lsdRadixArgsort(const std::vector<T> &v, int compareFlag = linear_sorting::INCREASING_ORDER);
+
+/** @brief String Key concept
+ * @details Types sorted by msdRadixSort(), \a std::string and \a std::string_view
+ */
+template<typename T>
+concept StringKey = std::same_as<T, std::string> || std::same_as<T, std::string_view>;
+
+/**@brief MSD Radix Sort Algorithm
+ * @details Sorts strings one character at a time from the first character on. Every pass 
+ * distributes a bucket by the character at the current depth (strings that end come first) and 
+ * recurses on the buckets with the next character, so a shared prefix is examined once per 
+ * bucket instead of once per comparison. Buckets smaller than 
+ * @ref linear_sorting::MULTIKEY_QUICKSORT_THRESHOLD are finished with multikey (three-way radix) 
+ * quick sort. Characters are compared as \a unsigned \a char, the order of \a std::string::compare.
+ *
+ * With more than one thread the largest bucket is distributed again until there is a bucket per
+ * thread, skipping the prefix its strings share, and the buckets are sorted in parallel on a
+ * ThreadPool.
+ *
+ * \f$O(D + n \log \sigma)\f$ where \f$D\f$ is the number of characters examined
+ * @param v \a std::vector of strings to be sorted in place
+ * @param compareFlag @ref linear_sorting constant defining sorted order
+ * @param threads number of threads, \a 0 uses all hardware threads
+ * @tparam T \a std::string or \a std::string_view
+ */
+template<StringKey T>
+extern void msdRadixSort(std::vector<T> &v, int compareFlag = linear_sorting::INCREASING_ORDER, size_t threads = 1);
+
+/** @brief Normalise the \a std::vector
+ * @details Applies \a compute to every value, without \a compute min-max scales the values to 
+ * the range \f$[0,1)\f$
  *
  *\f$O(n)\f$
  * @param v \a std::vector of values to be normalised
  * @param compute custom normalisation method
  * @tparam T Data type of the \a std::vector element - should be floating point
  */
-//TODO(Implement the function and compute callback function)
 template<std::floating_point T>
-extern void normalise(std::vector<T> &v, std::function<T(T)> compute);
+extern void normalise(std::vector<T> &v, std::function<T(T)> compute = nullptr);
 
 /**@brief Bucket Sort Algorithm
- * @details Sorts values in the range \f$[0,1)\f$ by bucketting the values then 
- * sorting the buckets using insertion sort
- *
- * Also see normalise()
+ * @details Distribution sort of values over any range. One pass finds the minimum and the 
+ * maximum, the values are scattered into equal width buckets of 
+ * @ref linear_sorting::BUCKET_SIZE values on average in one contiguous buffer through prefix 
+ * sums of the bucket sizes, then the buckets are sorted with insertion sort or networkSort(). 
+ * Buckets of skewed inputs larger than @ref sorting::NETWORK_SORT_THRESHOLD are distributed 
+ * again over their own range, \f$\pm\infty\f$ go to the outer buckets and NaNs to the end.
  *
- * \f$O(n)\f$
- * @param v \a std::vector of integral values to be sorted
+ * \f$O(n)\f$ for uniformly distributed values, \f$O(n \log n)\f$ worst case
+ * @param v \a std::vector of floating point values to be sorted
  * @param compareFlag @ref linear_sorting constant defining sorted order
  * @tparam T Data type of the \a std::vector elements - Should be floating_point 
  * @return Sorted vector
@@ -0,0 +1,197 @@
+#include"./parallel_sorting.hpp"
+
+namespace {
+
+    /*
+     * Index of the median of v[a], v[b] and v[c]
+     */
+    template<Comparable T, Comparator<T> Compare>
+        int medianIndex(std::vector<T> &v, int a, int b, int c, Compare &compare) {
+            if (compare(v[a], v[b])) std::swap(a, b);
+            if (compare(v[b], v[c])) {
+                return compare(v[a], v[c]) ? a : c;
+            }
+            return b;
+        }
+
+    /*
+     * Moves the median of three (or Tukey's ninther for large subarrays) of v[low..high]
+     * to v[high], where threeWayPartition() takes its pivot from
+     */
+    template<Comparable T, Comparator<T> Compare>
+        void medianToBack(std::vector<T> &v, int low, int high, Compare &compare) {
+            int n = high - low + 1;
+            int mid = low + n / 2;
+            int pivot;
+            if (n > sorting::NINTHER_THRESHOLD) {
+                int step = n / 8;
+                pivot = medianIndex(v,
+                        medianIndex(v, low, low + step, low + 2 * step, compare),
+                        medianIndex(v, mid - step, mid, mid + step, compare),
+                        medianIndex(v, high - 2 * step, high - step, high, compare),
+                        compare);
+            } else {
+                pivot = medianIndex(v, low, mid, high, compare);
+            }
+            std::swap(v[pivot], v[high]);
+        }
+
+    /*
+     * Partitions v[low..high] until the subarrays fit the grain, forking the smaller
+     * side onto the pool and iterating on the larger one
+     */
+    template<Comparable T, Comparator<T> Compare>
+        void parallelQuickSortTask(std::vector<T> &v, int low, int high, int depth, int grain,
+                Compare &compare, TaskGroup &group) {
+            while (high - low + 1 > grain) {
+                if (depth == 0) break;
+                depth--;
+                medianToBack(v, low, high, compare);
+                auto [lt, gt] = threeWayPartition(v, compare, low, high);
+                int forkLow = low, forkHigh = lt - 1;
+                if (lt - low < high - gt) {
+                    low = gt + 1;
+                } else {
+                    forkLow = gt + 1;
+                    forkHigh = high;
+                    high = lt - 1;
+                }
+                group.run([&v, forkLow, forkHigh, depth, grain, &compare, &group]() {
+                    parallelQuickSortTask(v, forkLow, forkHigh, depth, grain, compare, group);
+                });
+            }
+            introSort(v, compare, low, high);
+        }
+
+    /*
+     * Number of elements of the run a[aLow..aLow+aLen) among the first k elements of the
+     * stable merge of a with the run b[bLow..bLow+bLen)
+     */
+    template<Comparable T, Comparator<T> Compare>
+        int coRank(int k, const std::vector<T> &src, int aLow, int aLen, int bLow, int bLen, Compare &compare) {
+            int low = std::max(0, k - bLen), high = std::min(k, aLen);
+            while (low < high) {
+                int i = low + (high - low) / 2;
+                int j = k - i;
+                // a[i] precedes b[j-1], so more than i elements come from a
+                if (j > 0 && !compare(src[aLow + i], src[bLow + j - 1])) low = i + 1;
+                else high = i;
+            }
+            return low;
+        }
+
+    /*
+     * Stable merge of src[i..iEnd) and src[j..jEnd) into dst starting at dest
+     */
+    template<Comparable T, Comparator<T> Compare>
+        void mergeInto(std::vector<T> &src, std::vector<T> &dst, int i, int iEnd, int j, int jEnd, int dest,
+                Compare &compare) {
+            while (i < iEnd && j < jEnd) {
+                if (compare(src[i], src[j])) dst[dest++] = std::move(src[j++]);
+                else dst[dest++] = std::move(src[i++]);
+            }
+            std::move(src.begin() + i, src.begin() + iEnd, dst.begin() + dest);
+            std::move(src.begin() + j, src.begin() + jEnd, dst.begin() + dest + (iEnd - i));
+        }
+
+    /*
+     * Merges the adjacent runs src[low..mid) and src[mid..high) into dst[low..high), split into
+     * independent pieces of about grain elements. The split points are found before any piece
+     * starts moving elements out of src
+     */
+    template<Comparable T, Comparator<T> Compare>
+        void parallelMerge(std::vector<T> &src, std::vector<T> &dst, int low, int mid, int high, int grain,
+                Compare &compare, TaskGroup &group) {
+            int aLen = mid - low, bLen = high - mid, total = high - low;
+            int pieces = std::max(1, total / grain);
+            std::vector<int> splits(pieces + 1);
+            for (int p = 0; p <= pieces; p++) {
+                long long k = (long long) total * p / pieces;
+                splits[p] = coRank((int) k, src, low, aLen, mid, bLen, compare);
+            }
+            for (int p = 0; p < pieces; p++) {
+                int kLow = (int) ((long long) total * p / pieces);
+                int kHigh = (int) ((long long) total * (p + 1) / pieces);
+                int i = low + splits[p], iEnd = low + splits[p + 1];
+                int j = mid + kLow - splits[p], jEnd = mid + kHigh - splits[p + 1];
+                group.run([&src, &dst, i, iEnd, j, jEnd, dest = low + kLow, &compare]() {
+                    mergeInto(src, dst, i, iEnd, j, jEnd, dest, compare);
+                });
+            }
+        }
+
+    template<Comparable T, Comparator<T> Compare>
+        void parallelQuickSort(std::vector<T> &v, int grain, Compare &compare, ThreadPool &pool) {
+            TaskGroup group(pool);
+            int depth = 2 * (std::bit_width(v.size()) - 1);
+            parallelQuickSortTask(v, 0, (int) v.size() - 1, depth, grain, compare, group);
+            group.wait();
+        }
+
+    template<Comparable T, Comparator<T> Compare>
+        void parallelMergeSort(std::vector<T> &v, int grain, Compare &compare, ThreadPool &pool) {
+            TaskGroup group(pool);
+            int n = (int) v.size();
+            int chunks = (int) std::min<size_t>(pool.size(), std::max(1, n / grain));
+            std::vector<int> bounds;
+            for (int c = 0; c <= chunks; c++) {
+                bounds.push_back((int) ((long long) n * c / chunks));
+            }
+            for (int c = 0; c < chunks; c++) {
+                int low = bounds[c], high = bounds[c + 1] - 1;
+                group.run([&v, low, high, &compare]() {
+                    timSort(v, compare, low, high);
+                });
+            }
+            group.wait();
+
+            std::vector<T> buffer(n);
+            std::vector<T> *src = &v, *dst = &buffer;
+            while (bounds.size() > 2) {
+                std::vector<int> next;
+                size_t r = 0;
+                for (; r + 2 < bounds.size(); r += 2) {
+                    parallelMerge(*src, *dst, bounds[r], bounds[r + 1], bounds[r + 2], grain, compare, group);
+                    next.push_back(bounds[r]);
+                }
+                // odd run out, carried over to the next round
+                if (r + 2 == bounds.size()) {
+                    int low = bounds[r], high = bounds[r + 1];
+                    group.run([src, dst, low, high]() {
+                        std::move(src->begin() + low, src->begin() + high, dst->begin() + low);
+                    });
+                    next.push_back(bounds[r]);
+                }
+                next.push_back(n);
+                group.wait();
+                std::swap(src, dst);
+                bounds = std::move(next);
+            }
+            if (src != &v) {
+                for (int low = 0; low < n; low += grain) {
+                    int high = std::min(n, low + grain);
+                    group.run([src, &v, low, high]() {
+                        std::move(src->begin() + low, src->begin() + high, v.begin() + low);
+                    });
+                }
+                group.wait();
+            }
+        }
+}
+
+template<Comparable T, Comparator<T> Compare>
+void parallelSort(std::vector<T> &v, Compare compare, int method, size_t threads, size_t grain) {
+    if (threads == 0) threads = std::thread::hardware_concurrency();
+    grain = std::max<size_t>(grain, 2);
+    if (threads <= 1 || v.size() <= grain) {
+        if (method == parallel_sorting::MERGE_SORT) timSort(v, compare);
+        else introSort(v, compare);
+        return;
+    }
+    ThreadPool pool(threads);
+    if (method == parallel_sorting::MERGE_SORT) {
+        parallelMergeSort(v, (int) std::min<size_t>(grain, v.size()), compare, pool);
+    } else {
+        parallelQuickSort(v, (int) std::min<size_t>(grain, v.size()), compare, pool);
+    }
+}
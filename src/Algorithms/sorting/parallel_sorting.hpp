@@ -0,0 +1,66 @@
+/**
+ * @file parallel_sorting.hpp
+ * @brief Parallel Sorting Algorithms
+ * @details Multi-threaded comparison sorts running on a work stealing ThreadPool.
+ * @author Atishek Kumar
+ * @date May 2021
+ * @warning The comparison callback is called concurrently from several threads and must not throw.
+ */
+#ifndef ALGORITHMS_PARALLEL_SORTING_HPP
+#define ALGORITHMS_PARALLEL_SORTING_HPP
+
+#include<vector>
+#include<algorithm>
+#include<cstddef>
+
+#include"sorting.hpp"
+#include"../../Utils/thread_pool.hpp"
+
+/**@namespace parallel_sorting
+ * @details Constant flags selecting the algorithm and the default tuning of parallelSort()
+ */
+namespace parallel_sorting {
+    /** @brief Parallel quick sort, not stable
+     */
+    const int QUICK_SORT = 0;
+    /** @brief Parallel merge sort, stable
+     */
+    const int MERGE_SORT = 1;
+    /** @brief Default number of elements below which a subarray is sorted serially
+     */
+    const size_t DEFAULT_GRAIN = 1 << 14;
+}
+
+/**
+ * @brief Parallel Sort
+ *
+ * Sorts the vector on a work stealing pool of \a threads threads (the calling thread included).
+ * Increasing order by default.
+ *
+ * - @ref parallel_sorting::QUICK_SORT - ninther pivot with a three-way partition, the smaller 
+ *   side is forked as a task and the larger one partitioned further. Subarrays of at most 
+ *   \a grain elements are sorted with introSort().
+ * - @ref parallel_sorting::MERGE_SORT - stable. Chunks of at least \a grain elements are sorted 
+ *   with timSort() in parallel and merged pairwise, every merge split into independent pieces of 
+ *   \a grain elements by binary search. Needs a buffer of \a n elements, \a T must be 
+ *   default constructible.
+ *
+ * Vectors of at most \a grain elements, or a single thread, fall back to the serial sort.
+ *
+ * \f$O(n \log n)\f$ work
+ *
+ * @param v reference of the vector to be sorted
+ * @param compare comparison function, must be safe to call concurrently
+ * @param method @ref parallel_sorting flag selecting the algorithm
+ * @param threads number of threads, \a 0 uses all hardware threads
+ * @param grain number of elements below which the sort runs serially
+ * @tparam T data type of the \a std::vector elements
+ * @tparam Compare type of the comparison callable
+ * @return none
+ */
+template<Comparable T, Comparator<T> Compare = sorting::IncreasingOrder<T>>
+extern void parallelSort(std::vector<T> &v, Compare compare = Compare{}, 
+        int method = parallel_sorting::QUICK_SORT, size_t threads = 0, 
+        size_t grain = parallel_sorting::DEFAULT_GRAIN);
+
+#endif //ALGORITHMS_PARALLEL_SORTING_HPP
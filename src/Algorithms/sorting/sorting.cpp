@@ -1,46 +1,824 @@
 #include "sorting.hpp"
+#include "sorting_network.hpp"
 
 namespace {
     /*
-     * Helper Merge function
+     * Helper Merge function, moves the left half into the shared buffer and merges it back
      */
-    template<Comparable T>
-        void merge(std::vector<T> &v, int low, int mid, int high, std::function<bool(T, T)> compare) {
-            std::vector<T> L, R;
-            for (int i = low; i <= mid; i++) L.push_back(v[i]);
-            for (int i = mid + 1; i <= high; i++) R.push_back(v[i]);
-
-            int i = 0, j = 0;
-            for (int k = low; k <= high; k++) {
-                if (i == L.size()) {
-                    v[k] = R[j++];
-                } else if (j == R.size()) {
-                    v[k] = L[i++];
+    template<Comparable T, Comparator<T> Compare>
+        void merge(std::vector<T> &v, std::vector<T> &buffer, int low, int mid, int high, Compare &compare) {
+            buffer.clear();
+            buffer.insert(buffer.end(), std::make_move_iterator(v.begin() + low),
+                    std::make_move_iterator(v.begin() + mid + 1));
+
+            int i = 0, j = mid + 1, k = low;
+            int n = buffer.size();
+            while (i < n && j <= high) {
+                if (compare(buffer[i], v[j])) {
+                    v[k++] = std::move(v[j++]);
                 } else {
-                    if (compare(R[j], L[i])) {
-                        v[k] = L[i++];
-                    } else {
-                        v[k] = R[j++];
-                    }
+                    v[k++] = std::move(buffer[i++]);
                 }
             }
+            std::move(buffer.begin() + i, buffer.end(), v.begin() + k);
         }
 
     /*
      * Recursive merge sort helper function
      */
-    template<Comparable T>
-        void mergeSortRecur(std::vector<T> &v, int low, int high, std::function<bool(T, T)> compare) {
+    template<Comparable T, Comparator<T> Compare>
+        void mergeSortRecur(std::vector<T> &v, std::vector<T> &buffer, int low, int high, Compare &compare) {
+            // integers only, the network could swap floating point -0.0 and 0.0 and break stability
+            if constexpr (sorting::networkSortable<T, Compare> && std::integral<T>) {
+                if (high - low < sorting::NETWORK_SORT_THRESHOLD) {
+                    networkSort(v, compare, low, high);
+                    return;
+                }
+            }
             if (low < high) {
                 int mid = (low + high) / 2;
-                mergeSortRecur(v, low, mid, compare);
-                mergeSortRecur(v, mid + 1, high, compare);
-                merge(v, low, mid, high, compare);
+                mergeSortRecur(v, buffer, low, mid, compare);
+                mergeSortRecur(v, buffer, mid + 1, high, compare);
+                merge(v, buffer, low, mid, high, compare);
+            }
+        }
+
+    /*
+     * Galloping search for the leftmost insertion point of key in a[base..base+len), starting
+     * from a[base+hint]. Returns k such that a[base+k-1] < key <= a[base+k]
+     */
+    template<Comparable T, Comparator<T> Compare>
+        int gallopLeft(const T &key, const std::vector<T> &a, int base, int len, int hint, Compare &compare) {
+            int lastOfs = 0, ofs = 1;
+            if (compare(key, a[base + hint])) {
+                int maxOfs = len - hint;
+                while (ofs < maxOfs && compare(key, a[base + hint + ofs])) {
+                    lastOfs = ofs;
+                    ofs = (ofs << 1) + 1;
+                    if (ofs <= 0) ofs = maxOfs;
+                }
+                if (ofs > maxOfs) ofs = maxOfs;
+                lastOfs += hint;
+                ofs += hint;
+            } else {
+                int maxOfs = hint + 1;
+                while (ofs < maxOfs && !compare(key, a[base + hint - ofs])) {
+                    lastOfs = ofs;
+                    ofs = (ofs << 1) + 1;
+                    if (ofs <= 0) ofs = maxOfs;
+                }
+                if (ofs > maxOfs) ofs = maxOfs;
+                int tmp = lastOfs;
+                lastOfs = hint - ofs;
+                ofs = hint - tmp;
+            }
+            lastOfs++;
+            while (lastOfs < ofs) {
+                int m = lastOfs + (ofs - lastOfs) / 2;
+                if (compare(key, a[base + m])) lastOfs = m + 1;
+                else ofs = m;
+            }
+            return ofs;
+        }
+
+    /*
+     * Galloping search for the rightmost insertion point of key in a[base..base+len), starting
+     * from a[base+hint]. Returns k such that a[base+k-1] <= key < a[base+k]
+     */
+    template<Comparable T, Comparator<T> Compare>
+        int gallopRight(const T &key, const std::vector<T> &a, int base, int len, int hint, Compare &compare) {
+            int lastOfs = 0, ofs = 1;
+            if (compare(a[base + hint], key)) {
+                int maxOfs = hint + 1;
+                while (ofs < maxOfs && compare(a[base + hint - ofs], key)) {
+                    lastOfs = ofs;
+                    ofs = (ofs << 1) + 1;
+                    if (ofs <= 0) ofs = maxOfs;
+                }
+                if (ofs > maxOfs) ofs = maxOfs;
+                int tmp = lastOfs;
+                lastOfs = hint - ofs;
+                ofs = hint - tmp;
+            } else {
+                int maxOfs = len - hint;
+                while (ofs < maxOfs && !compare(a[base + hint + ofs], key)) {
+                    lastOfs = ofs;
+                    ofs = (ofs << 1) + 1;
+                    if (ofs <= 0) ofs = maxOfs;
+                }
+                if (ofs > maxOfs) ofs = maxOfs;
+                lastOfs += hint;
+                ofs += hint;
+            }
+            lastOfs++;
+            while (lastOfs < ofs) {
+                int m = lastOfs + (ofs - lastOfs) / 2;
+                if (compare(a[base + m], key)) ofs = m;
+                else lastOfs = m + 1;
+            }
+            return ofs;
+        }
+
+    /*
+     * Stable natural merge sort state, holds the run stack and the single scratch buffer
+     * reused by every merge
+     */
+    template<Comparable T, Comparator<T> Compare>
+        class TimSorter {
+        private:
+            std::vector<T> &v;
+            Compare &compare;
+            std::vector<T> buffer;
+            std::vector<int> runBase, runLen;
+            int minGallop = sorting::MIN_GALLOP;
+
+            /*
+             * Moves v[from..from+n) to v[to..to+n), regions may overlap
+             */
+            void moveRange(int from, int to, int n) {
+                if (to < from) std::move(v.begin() + from, v.begin() + from + n, v.begin() + to);
+                else std::move_backward(v.begin() + from, v.begin() + from + n, v.begin() + to + n);
+            }
+
+            /*
+             * Merges the runs v[base1..base1+len1) and v[base2..base2+len2) with len1 <= len2,
+             * the first run is moved into the buffer and merged forwards
+             */
+            void mergeLo(int base1, int len1, int base2, int len2) {
+                buffer.clear();
+                buffer.insert(buffer.end(), std::make_move_iterator(v.begin() + base1),
+                        std::make_move_iterator(v.begin() + base1 + len1));
+                int cursor1 = 0, cursor2 = base2, dest = base1;
+                v[dest++] = std::move(v[cursor2++]);
+                if (--len2 == 0) {
+                    std::move(buffer.begin(), buffer.begin() + len1, v.begin() + dest);
+                    return;
+                }
+                if (len1 == 1) {
+                    moveRange(cursor2, dest, len2);
+                    v[dest + len2] = std::move(buffer[cursor1]);
+                    return;
+                }
+                bool done = false;
+                while (!done) {
+                    int count1 = 0, count2 = 0;
+                    // one at a time until a run starts winning consistently
+                    do {
+                        if (compare(buffer[cursor1], v[cursor2])) {
+                            v[dest++] = std::move(v[cursor2++]);
+                            count2++;
+                            count1 = 0;
+                            if (--len2 == 0) done = true;
+                        } else {
+                            v[dest++] = std::move(buffer[cursor1++]);
+                            count1++;
+                            count2 = 0;
+                            if (--len1 == 1) done = true;
+                        }
+                    } while (!done && (count1 | count2) < minGallop);
+                    // galloping mode
+                    while (!done) {
+                        count1 = gallopRight(v[cursor2], buffer, cursor1, len1, 0, compare);
+                        if (count1 != 0) {
+                            std::move(buffer.begin() + cursor1, buffer.begin() + cursor1 + count1, v.begin() + dest);
+                            dest += count1;
+                            cursor1 += count1;
+                            len1 -= count1;
+                            if (len1 <= 1) {
+                                done = true;
+                                break;
+                            }
+                        }
+                        v[dest++] = std::move(v[cursor2++]);
+                        if (--len2 == 0) {
+                            done = true;
+                            break;
+                        }
+                        count2 = gallopLeft(buffer[cursor1], v, cursor2, len2, 0, compare);
+                        if (count2 != 0) {
+                            moveRange(cursor2, dest, count2);
+                            dest += count2;
+                            cursor2 += count2;
+                            len2 -= count2;
+                            if (len2 == 0) {
+                                done = true;
+                                break;
+                            }
+                        }
+                        v[dest++] = std::move(buffer[cursor1++]);
+                        if (--len1 == 1) {
+                            done = true;
+                            break;
+                        }
+                        minGallop--;
+                        if (count1 < sorting::MIN_GALLOP && count2 < sorting::MIN_GALLOP) break;
+                    }
+                    if (minGallop < 0) minGallop = 0;
+                    minGallop += 2;
+                }
+                if (minGallop < 1) minGallop = 1;
+                if (len1 == 1) {
+                    moveRange(cursor2, dest, len2);
+                    v[dest + len2] = std::move(buffer[cursor1]);
+                } else {
+                    std::move(buffer.begin() + cursor1, buffer.begin() + cursor1 + len1, v.begin() + dest);
+                }
+            }
+
+            /*
+             * Merges the runs v[base1..base1+len1) and v[base2..base2+len2) with len1 > len2,
+             * the second run is moved into the buffer and merged backwards
+             */
+            void mergeHi(int base1, int len1, int base2, int len2) {
+                buffer.clear();
+                buffer.insert(buffer.end(), std::make_move_iterator(v.begin() + base2),
+                        std::make_move_iterator(v.begin() + base2 + len2));
+                int cursor1 = base1 + len1 - 1, cursor2 = len2 - 1, dest = base2 + len2 - 1;
+                v[dest--] = std::move(v[cursor1--]);
+                if (--len1 == 0) {
+                    std::move(buffer.begin(), buffer.begin() + len2, v.begin() + dest - (len2 - 1));
+                    return;
+                }
+                if (len2 == 1) {
+                    dest -= len1;
+                    cursor1 -= len1;
+                    moveRange(cursor1 + 1, dest + 1, len1);
+                    v[dest] = std::move(buffer[cursor2]);
+                    return;
+                }
+                bool done = false;
+                while (!done) {
+                    int count1 = 0, count2 = 0;
+                    do {
+                        if (compare(v[cursor1], buffer[cursor2])) {
+                            v[dest--] = std::move(v[cursor1--]);
+                            count1++;
+                            count2 = 0;
+                            if (--len1 == 0) done = true;
+                        } else {
+                            v[dest--] = std::move(buffer[cursor2--]);
+                            count2++;
+                            count1 = 0;
+                            if (--len2 == 1) done = true;
+                        }
+                    } while (!done && (count1 | count2) < minGallop);
+                    while (!done) {
+                        count1 = len1 - gallopRight(buffer[cursor2], v, base1, len1, len1 - 1, compare);
+                        if (count1 != 0) {
+                            dest -= count1;
+                            cursor1 -= count1;
+                            len1 -= count1;
+                            moveRange(cursor1 + 1, dest + 1, count1);
+                            if (len1 == 0) {
+                                done = true;
+                                break;
+                            }
+                        }
+                        v[dest--] = std::move(buffer[cursor2--]);
+                        if (--len2 == 1) {
+                            done = true;
+                            break;
+                        }
+                        count2 = len2 - gallopLeft(v[cursor1], buffer, 0, len2, len2 - 1, compare);
+                        if (count2 != 0) {
+                            dest -= count2;
+                            cursor2 -= count2;
+                            len2 -= count2;
+                            std::move(buffer.begin() + cursor2 + 1, buffer.begin() + cursor2 + 1 + count2, v.begin() + dest + 1);
+                            if (len2 <= 1) {
+                                done = true;
+                                break;
+                            }
+                        }
+                        v[dest--] = std::move(v[cursor1--]);
+                        if (--len1 == 0) {
+                            done = true;
+                            break;
+                        }
+                        minGallop--;
+                        if (count1 < sorting::MIN_GALLOP && count2 < sorting::MIN_GALLOP) break;
+                    }
+                    if (minGallop < 0) minGallop = 0;
+                    minGallop += 2;
+                }
+                if (minGallop < 1) minGallop = 1;
+                if (len2 == 1) {
+                    dest -= len1;
+                    cursor1 -= len1;
+                    moveRange(cursor1 + 1, dest + 1, len1);
+                    v[dest] = std::move(buffer[cursor2]);
+                } else {
+                    std::move(buffer.begin(), buffer.begin() + len2, v.begin() + dest - (len2 - 1));
+                }
+            }
+
+            /*
+             * Merges the runs i and i+1 of the run stack
+             */
+            void mergeAt(int i) {
+                int base1 = runBase[i], len1 = runLen[i];
+                int base2 = runBase[i + 1], len2 = runLen[i + 1];
+                runLen[i] = len1 + len2;
+                runBase.erase(runBase.begin() + i + 1);
+                runLen.erase(runLen.begin() + i + 1);
+                // elements of the first run already in place
+                int k = gallopRight(v[base2], v, base1, len1, 0, compare);
+                base1 += k;
+                len1 -= k;
+                if (len1 == 0) return;
+                // elements of the second run already in place
+                len2 = gallopLeft(v[base1 + len1 - 1], v, base2, len2, len2 - 1, compare);
+                if (len2 == 0) return;
+                if (len1 <= len2) mergeLo(base1, len1, base2, len2);
+                else mergeHi(base1, len1, base2, len2);
+            }
+
+            /*
+             * Restores the run stack invariants len[i-2] > len[i-1] + len[i] and len[i-1] > len[i]
+             */
+            void mergeCollapse() {
+                while (runLen.size() > 1) {
+                    int n = (int) runLen.size() - 2;
+                    if ((n > 0 && runLen[n - 1] <= runLen[n] + runLen[n + 1]) ||
+                            (n > 1 && runLen[n - 2] <= runLen[n - 1] + runLen[n])) {
+                        if (runLen[n - 1] < runLen[n + 1]) n--;
+                    } else if (runLen[n] > runLen[n + 1]) {
+                        break;
+                    }
+                    mergeAt(n);
+                }
+            }
+
+            void mergeForceCollapse() {
+                while (runLen.size() > 1) {
+                    int n = (int) runLen.size() - 2;
+                    if (n > 0 && runLen[n - 1] < runLen[n + 1]) n--;
+                    mergeAt(n);
+                }
+            }
+
+            /*
+             * Length of the natural run starting at v[low] and ending before v[end],
+             * strictly descending runs are reversed
+             */
+            int countRun(int low, int end) {
+                int i = low + 1;
+                if (i == end) return 1;
+                if (compare(v[low], v[i])) {
+                    while (i + 1 < end && compare(v[i], v[i + 1])) i++;
+                    std::reverse(v.begin() + low, v.begin() + i + 1);
+                } else {
+                    while (i + 1 < end && !compare(v[i], v[i + 1])) i++;
+                }
+                return i - low + 1;
+            }
+
+            /*
+             * Binary insertion sort of v[low..high) where v[low..start) is already sorted
+             */
+            void binaryInsertionSort(int low, int high, int start) {
+                for (int i = start; i < high; i++) {
+                    T pivot = std::move(v[i]);
+                    int left = low, right = i;
+                    while (left < right) {
+                        int mid = left + (right - left) / 2;
+                        if (compare(v[mid], pivot)) right = mid;
+                        else left = mid + 1;
+                    }
+                    std::move_backward(v.begin() + left, v.begin() + i, v.begin() + i + 1);
+                    v[left] = std::move(pivot);
+                }
+            }
+
+            static int minRunLength(int n) {
+                int r = 0;
+                while (n >= sorting::MIN_MERGE) {
+                    r |= n & 1;
+                    n >>= 1;
+                }
+                return n + r;
+            }
+
+        public:
+            TimSorter(std::vector<T> &v, Compare &compare) : v(v), compare(compare) {}
+
+            /*
+             * Sorts v[low..end)
+             */
+            void sort(int low, int end) {
+                int n = end - low;
+                if (n < 2) return;
+                if (n < sorting::MIN_MERGE) {
+                    binaryInsertionSort(low, end, low + countRun(low, end));
+                    return;
+                }
+                buffer.reserve(n / 2);
+                int minRun = minRunLength(n);
+                while (low < end) {
+                    int len = countRun(low, end);
+                    // extend short runs to minRun with insertion sort
+                    if (len < minRun) {
+                        int forced = std::min(minRun, end - low);
+                        binaryInsertionSort(low, low + forced, low + len);
+                        len = forced;
+                    }
+                    runBase.push_back(low);
+                    runLen.push_back(len);
+                    mergeCollapse();
+                    low += len;
+                }
+                mergeForceCollapse();
+            }
+        };
+
+    /*
+     * Insertion sort on the subarray v[low..high]
+     */
+    template<Comparable T, Comparator<T> Compare>
+        void insertionSortRange(std::vector<T> &v, int low, int high, Compare &compare) {
+            for (int j = low + 1; j <= high; j++) {
+                T key = std::move(v[j]);
+                int i = j - 1;
+                while (i >= low && compare(v[i], key)) {
+                    v[i + 1] = std::move(v[i]);
+                    i--;
+                }
+                v[i + 1] = std::move(key);
+            }
+        }
+
+    /*
+     * Float down v[low + i] in the heap stored in v[low..low+n-1]
+     */
+    template<Comparable T, Comparator<T> Compare>
+        void siftDown(std::vector<T> &v, int low, int i, int n, Compare &compare) {
+            T value = std::move(v[low + i]);
+            int child;
+            while ((child = 2 * i + 1) < n) {
+                if (child + 1 < n && compare(v[low + child + 1], v[low + child])) child++;
+                if (!compare(v[low + child], value)) break;
+                v[low + i] = std::move(v[low + child]);
+                i = child;
+            }
+            v[low + i] = std::move(value);
+        }
+
+    /*
+     * In place heap sort on the subarray v[low..high]
+     */
+    template<Comparable T, Comparator<T> Compare>
+        void heapSortRange(std::vector<T> &v, int low, int high, Compare &compare) {
+            int n = high - low + 1;
+            for (int i = n / 2 - 1; i >= 0; i--) {
+                siftDown(v, low, i, n, compare);
+            }
+            for (int last = n - 1; last > 0; last--) {
+                std::swap(v[low], v[low + last]);
+                siftDown(v, low, 0, last, compare);
+            }
+        }
+
+    /*
+     * Orders v[a], v[b], v[c] and leaves the median at v[b]
+     */
+    template<Comparable T, Comparator<T> Compare>
+        void sort3(std::vector<T> &v, int a, int b, int c, Compare &compare) {
+            if (compare(v[a], v[b])) std::swap(v[a], v[b]);
+            if (compare(v[b], v[c])) std::swap(v[b], v[c]);
+            if (compare(v[a], v[b])) std::swap(v[a], v[b]);
+        }
+
+    /*
+     * Moves the median of three (or Tukey's ninther for large subarrays) to v[low]
+     */
+    template<Comparable T, Comparator<T> Compare>
+        void choosePivot(std::vector<T> &v, int low, int high, Compare &compare) {
+            int n = high - low + 1;
+            int mid = low + n / 2;
+            if (n > sorting::NINTHER_THRESHOLD) {
+                int step = n / 8;
+                sort3(v, low, low + step, low + 2 * step, compare);
+                sort3(v, mid - step, mid, mid + step, compare);
+                sort3(v, high - 2 * step, high - step, high, compare);
+                sort3(v, low + step, mid, high - step, compare);
+            } else {
+                sort3(v, low, mid, high, compare);
+            }
+            std::swap(v[low], v[mid]);
+        }
+
+    /*
+     * Hoare partition about the pivot at v[low], elements equal to the pivot stop both
+     * scans so runs of equal keys are split evenly. Returns the final position of the pivot
+     */
+    template<Comparable T, Comparator<T> Compare>
+        int hoarePartition(std::vector<T> &v, int low, int high, Compare &compare) {
+            const T &pivot = v[low];
+            int i = low, j = high + 1;
+            while (true) {
+                while (compare(pivot, v[++i])) {
+                    if (i == high) break;
+                }
+                while (compare(v[--j], pivot)) {
+                    if (j == low) break;
+                }
+                if (i >= j) break;
+                std::swap(v[i], v[j]);
+            }
+            std::swap(v[low], v[j]);
+            return j;
+        }
+
+    /*
+     * Intro sort loop, recurses on the smaller partition and iterates on the larger one
+     */
+    template<Comparable T, Comparator<T> Compare>
+        void introSortLoop(std::vector<T> &v, int low, int high, int depth, Compare &compare) {
+            while (high - low + 1 > sorting::INSERTION_SORT_THRESHOLD) {
+                if (depth == 0) {
+                    heapSortRange(v, low, high, compare);
+                    return;
+                }
+                depth--;
+                choosePivot(v, low, high, compare);
+                int q = hoarePartition(v, low, high, compare);
+                if (q - low < high - q) {
+                    introSortLoop(v, low, q - 1, depth, compare);
+                    low = q + 1;
+                } else {
+                    introSortLoop(v, q + 1, high, depth, compare);
+                    high = q - 1;
+                }
+            }
+            if constexpr (sorting::networkSortable<T, Compare>) networkSort(v, compare, low, high);
+            else insertionSortRange(v, low, high, compare);
+        }
+
+    /*
+     * Arithmetic types compared with the predefined comparators can be partitioned branchlessly
+     */
+    template<typename T, typename Compare>
+        constexpr bool branchlessPartition = std::is_arithmetic_v<T> &&
+            (std::is_same_v<Compare, sorting::IncreasingOrder<T>> || std::is_same_v<Compare, sorting::DecreasingOrder<T>>);
+
+    /*
+     * Insertion sort on v[low..high] without the lower bound check,
+     * requires v[low - 1] to be ordered before every element of the subarray
+     */
+    template<Comparable T, Comparator<T> Compare>
+        void unguardedInsertionSort(std::vector<T> &v, int low, int high, Compare &compare) {
+            for (int j = low + 1; j <= high; j++) {
+                if (!compare(v[j - 1], v[j])) continue;
+                T key = std::move(v[j]);
+                int i = j - 1;
+                do {
+                    v[i + 1] = std::move(v[i]);
+                    i--;
+                } while (compare(v[i], key));
+                v[i + 1] = std::move(key);
+            }
+        }
+
+    /*
+     * Insertion sort on v[low..high] that gives up once more than
+     * PARTIAL_INSERTION_SORT_LIMIT elements have been moved. Returns true if the subarray is sorted
+     */
+    template<Comparable T, Comparator<T> Compare>
+        bool partialInsertionSort(std::vector<T> &v, int low, int high, Compare &compare) {
+            int moved = 0;
+            for (int j = low + 1; j <= high; j++) {
+                if (compare(v[j - 1], v[j])) {
+                    T key = std::move(v[j]);
+                    int i = j - 1;
+                    do {
+                        v[i + 1] = std::move(v[i]);
+                        i--;
+                    } while (i >= low && compare(v[i], key));
+                    v[i + 1] = std::move(key);
+                    moved += j - i - 1;
+                }
+                if (moved > sorting::PARTIAL_INSERTION_SORT_LIMIT) return false;
+            }
+            return true;
+        }
+
+    /*
+     * Partition v[low..high] about the pivot at v[low], elements equal to the pivot go to the left.
+     * Used when the pivot equals the pivot of the parent partition, so the left part is a run
+     * of equal keys. Returns the final position of the pivot
+     */
+    template<Comparable T, Comparator<T> Compare>
+        int partitionLeft(std::vector<T> &v, int low, int high, Compare &compare) {
+            T pivot = std::move(v[low]);
+            int i = low, j = high + 1;
+            while (compare(v[--j], pivot));
+            if (j == high) {
+                while (i < j && !compare(v[++i], pivot));
+            } else {
+                while (!compare(v[++i], pivot));
+            }
+            while (i < j) {
+                std::swap(v[i], v[j]);
+                while (compare(v[--j], pivot));
+                while (!compare(v[++i], pivot));
+            }
+            v[low] = std::move(v[j]);
+            v[j] = std::move(pivot);
+            return j;
+        }
+
+    /*
+     * Partition v[low..high] about the pivot at v[low], elements equal to the pivot go to the right.
+     * Returns the final position of the pivot and whether the subarray was already partitioned
+     */
+    template<Comparable T, Comparator<T> Compare>
+        std::pair<int, bool> partitionRight(std::vector<T> &v, int low, int high, Compare &compare) {
+            T pivot = std::move(v[low]);
+            int i = low, j = high + 1;
+            // the median of three guarantees an element not ordered before the pivot on the right
+            while (compare(pivot, v[++i]));
+            if (i - 1 == low) {
+                while (i < j && !compare(pivot, v[--j]));
+            } else {
+                while (!compare(pivot, v[--j]));
+            }
+            bool partitioned = i >= j;
+            while (i < j) {
+                std::swap(v[i], v[j]);
+                while (compare(pivot, v[++i]));
+                while (!compare(pivot, v[--j]));
+            }
+            int q = i - 1;
+            v[low] = std::move(v[q]);
+            v[q] = std::move(pivot);
+            return std::make_pair(q, partitioned);
+        }
+
+    /*
+     * Swaps the misplaced elements recorded in the offset buffers of blockPartitionRight(),
+     * using a cyclic permutation when the counts differ to save moves
+     */
+    template<Comparable T>
+        void swapOffsets(std::vector<T> &v, int leftBase, int rightBase,
+                unsigned char *left, unsigned char *right, int n, bool useSwaps) {
+            if (useSwaps) {
+                for (int k = 0; k < n; k++) {
+                    std::swap(v[leftBase + left[k]], v[rightBase - right[k]]);
+                }
+            } else if (n > 0) {
+                int l = leftBase + left[0], r = rightBase - right[0];
+                T tmp = std::move(v[l]);
+                v[l] = std::move(v[r]);
+                for (int k = 1; k < n; k++) {
+                    l = leftBase + left[k];
+                    v[r] = std::move(v[l]);
+                    r = rightBase - right[k];
+                    v[l] = std::move(v[r]);
+                }
+                v[r] = std::move(tmp);
+            }
+        }
+
+    /*
+     * Branchless variant of partitionRight(). Scans blocks from both ends recording the offsets of
+     * misplaced elements without branching on the comparison, then swaps them in bulk
+     */
+    template<Comparable T, Comparator<T> Compare>
+        std::pair<int, bool> blockPartitionRight(std::vector<T> &v, int low, int high, Compare &compare) {
+            constexpr int BLOCK = sorting::BLOCK_PARTITION_SIZE;
+            T pivot = std::move(v[low]);
+            int i = low, j = high + 1;
+            while (compare(pivot, v[++i]));
+            if (i - 1 == low) {
+                while (i < j && !compare(pivot, v[--j]));
+            } else {
+                while (!compare(pivot, v[--j]));
+            }
+            bool partitioned = i >= j;
+            if (!partitioned) {
+                std::swap(v[i], v[j]);
+                i++;
+                // i and j now delimit the unscanned elements v[i..j)
+                alignas(64) unsigned char left[BLOCK], right[BLOCK];
+                int leftBase = i, rightBase = j;
+                int nLeft = 0, nRight = 0, startLeft = 0, startRight = 0;
+                while (i < j) {
+                    int unknown = j - i;
+                    int leftSplit = nLeft == 0 ? (nRight == 0 ? unknown / 2 : unknown) : 0;
+                    int rightSplit = nRight == 0 ? unknown - leftSplit : 0;
+                    if (leftSplit > BLOCK) leftSplit = BLOCK;
+                    if (rightSplit > BLOCK) rightSplit = BLOCK;
+                    for (int k = 0; k < leftSplit; k++) {
+                        left[nLeft] = (unsigned char) k;
+                        nLeft += !compare(pivot, v[i]);
+                        i++;
+                    }
+                    for (int k = 0; k < rightSplit;) {
+                        right[nRight] = (unsigned char) ++k;
+                        nRight += compare(pivot, v[--j]);
+                    }
+                    int n = std::min(nLeft, nRight);
+                    swapOffsets(v, leftBase, rightBase, left + startLeft, right + startRight, n, nLeft == nRight);
+                    nLeft -= n;
+                    nRight -= n;
+                    startLeft += n;
+                    startRight += n;
+                    if (nLeft == 0) {
+                        startLeft = 0;
+                        leftBase = i;
+                    }
+                    if (nRight == 0) {
+                        startRight = 0;
+                        rightBase = j;
+                    }
+                }
+                // at most one side has leftover misplaced elements, move them to the boundary
+                if (nLeft) {
+                    while (nLeft--) std::swap(v[leftBase + left[startLeft + nLeft]], v[--j]);
+                    i = j;
+                }
+                if (nRight) {
+                    while (nRight--) std::swap(v[rightBase - right[startRight + nRight]], v[i++]);
+                    j = i;
+                }
             }
+            int q = i - 1;
+            v[low] = std::move(v[q]);
+            v[q] = std::move(pivot);
+            return std::make_pair(q, partitioned);
         }
 
+    /*
+     * Breaks up adversarial patterns in v[low..high] after a highly unbalanced partition
+     * by swapping a few elements at fixed offsets
+     */
     template<Comparable T>
-        void quickSortRecur(std::vector<T> &v, int low, int high, std::function<bool(T,T)> compare) {
+        void breakPatterns(std::vector<T> &v, int low, int high) {
+            int n = high - low + 1;
+            if (n < sorting::INSERTION_SORT_THRESHOLD) return;
+            std::swap(v[low], v[low + n / 4]);
+            std::swap(v[high], v[high + 1 - n / 4]);
+            if (n > sorting::NINTHER_THRESHOLD) {
+                std::swap(v[low + 1], v[low + n / 4 + 1]);
+                std::swap(v[low + 2], v[low + n / 4 + 2]);
+                std::swap(v[high - 1], v[high - n / 4]);
+                std::swap(v[high - 2], v[high - n / 4 - 1]);
+            }
+        }
+
+    /*
+     * Pattern defeating quick sort loop on v[low..high]. `leftmost` is false when v[low - 1] holds
+     * the pivot of an enclosing partition, which is ordered before or equal to every element here
+     */
+    template<Comparable T, Comparator<T> Compare>
+        void pdqSortLoop(std::vector<T> &v, int low, int high, int badAllowed, bool leftmost, Compare &compare) {
+            while (true) {
+                int n = high - low + 1;
+                if (n <= sorting::INSERTION_SORT_THRESHOLD) {
+                    if (leftmost) insertionSortRange(v, low, high, compare);
+                    else unguardedInsertionSort(v, low, high, compare);
+                    return;
+                }
+                choosePivot(v, low, high, compare);
+                // equal to the parent pivot, partition out the run of equal keys and skip it
+                if (!leftmost && !compare(v[low], v[low - 1])) {
+                    low = partitionLeft(v, low, high, compare) + 1;
+                    continue;
+                }
+                std::pair<int, bool> result;
+                if constexpr (branchlessPartition<T, Compare>) {
+                    result = blockPartitionRight(v, low, high, compare);
+                } else {
+                    result = partitionRight(v, low, high, compare);
+                }
+                auto [q, partitioned] = result;
+                int leftSize = q - low, rightSize = high - q;
+                if (leftSize < n / 8 || rightSize < n / 8) {
+                    if (--badAllowed == 0) {
+                        heapSortRange(v, low, high, compare);
+                        return;
+                    }
+                    breakPatterns(v, low, q - 1);
+                    breakPatterns(v, q + 1, high);
+                } else if (partitioned &&
+                        partialInsertionSort(v, low, q - 1, compare) &&
+                        partialInsertionSort(v, q + 1, high, compare)) {
+                    return;
+                }
+                pdqSortLoop(v, low, q - 1, badAllowed, leftmost, compare);
+                low = q + 1;
+                leftmost = false;
+            }
+        }
+
+    template<Comparable T, Comparator<T> Compare>
+        void quickSortRecur(std::vector<T> &v, int low, int high, Compare &compare) {
+            if constexpr (sorting::networkSortable<T, Compare>) {
+                if(high - low < sorting::NETWORK_SORT_THRESHOLD) {
+                    networkSort(v, compare, low, high);
+                    return;
+                }
+            }
             if(low < high) {
                 int q = partition(v, compare, low, high);
                 quickSortRecur(v, low, q-1, compare);
@@ -48,8 +826,8 @@ namespace {
             }
         }
 
-    template<Comparable T>
-        void randomisedQuickSortRecur(std::vector<T> &v, int low, int high, std::function<bool(T,T)> compare) {
+    template<Comparable T, Comparator<T> Compare>
+        void randomisedQuickSortRecur(std::vector<T> &v, int low, int high, Compare &compare) {
             if(low < high) {
                 int q = randomisedPartition(v, compare, low, high);
                 randomisedQuickSortRecur(v, low, q-1, compare);
@@ -58,24 +836,18 @@ namespace {
         }
 }
 
-template<Comparable T>
-void insertionSort(std::vector<T> &v, std::function<bool(T, T)> compare) {
-    for (int j = 1; j < v.size(); j++) {
-        T key = v[j];
-        int i = j - 1;
-        while (i >= 0 && compare(v[i], key)) {
-            v[i + 1] = v[i];
-            i--;
-        }
-        v[i + 1] = key;
-    }
+template<Comparable T, Comparator<T> Compare>
+void insertionSort(std::vector<T> &v, Compare compare) {
+    insertionSortRange(v, 0, (int) v.size() - 1, compare);
 }
 
 
 
-template<Comparable T>
-void mergeSort(std::vector<T> &v, std::function<bool(T, T)> compare) {
-    mergeSortRecur(v, 0, v.size() - 1, compare);
+template<Comparable T, Comparator<T> Compare>
+void mergeSort(std::vector<T> &v, Compare compare) {
+    std::vector<T> buffer;
+    buffer.reserve((v.size() + 1) / 2);
+    mergeSortRecur(v, buffer, 0, (int) v.size() - 1, compare);
 }
 
 
@@ -87,9 +859,9 @@ void heapSort(std::vector<T> &v, int compareFlag) {
     }
 }
 
-template<Comparable T>
-int partition(std::vector<T> &v, std::function<bool(T,T)> compare, int low, int high) {
-    T pivot = v[high];
+template<Comparable T, Comparator<T> Compare>
+int partition(std::vector<T> &v, Compare compare, int low, int high) {
+    const T &pivot = v[high];
     int i = low - 1;
     for(int j = low; j < high; j++) {
         if(compare(pivot, v[j])) {
@@ -101,13 +873,29 @@ int partition(std::vector<T> &v, std::function<bool(T,T)> compare, int low, int
     return i+1;
 }
 
-template<Comparable T>
-void quickSort(std::vector<T> &v, std::function<bool(T,T)> compare) {
+template<Comparable T, Comparator<T> Compare>
+std::pair<int, int> threeWayPartition(std::vector<T> &v, Compare compare, int low, int high) {
+    T pivot = v[high];
+    int lt = low, i = low, gt = high;
+    while(i <= gt) {
+        if(compare(pivot, v[i])) {
+            std::swap(v[lt++], v[i++]);
+        } else if(compare(v[i], pivot)) {
+            std::swap(v[i], v[gt--]);
+        } else {
+            i++;
+        }
+    }
+    return std::make_pair(lt, gt);
+}
+
+template<Comparable T, Comparator<T> Compare>
+void quickSort(std::vector<T> &v, Compare compare) {
     quickSortRecur(v, 0, v.size() - 1, compare);
 }
 
-template<Comparable T>
-int randomisedPartition(std::vector<T> &v, std::function<bool(T,T)> compare, int low, int high) {
+template<Comparable T, Comparator<T> Compare>
+int randomisedPartition(std::vector<T> &v, Compare compare, int low, int high) {
     std::random_device rd;
     std::default_random_engine e(rd());
     std::uniform_int_distribution<> randomInt(low, high);
@@ -116,8 +904,39 @@ int randomisedPartition(std::vector<T> &v, std::function<bool(T,T)> compare, int
     return partition(v, compare, low, high);
 }
 
-template<Comparable T>
-void randomisedQuickSort(std::vector<T> &v, std::function<bool(T,T)> compare) {
+template<Comparable T, Comparator<T> Compare>
+void randomisedQuickSort(std::vector<T> &v, Compare compare) {
     randomisedQuickSortRecur(v, 0, v.size() - 1, compare);
 }
 
+
+template<Comparable T, Comparator<T> Compare>
+void introSort(std::vector<T> &v, Compare compare) {
+    if (v.size() < 2) return;
+    int depth = 2 * (std::bit_width(v.size()) - 1);
+    introSortLoop(v, 0, (int) v.size() - 1, depth, compare);
+}
+
+template<Comparable T, Comparator<T> Compare>
+void introSort(std::vector<T> &v, Compare compare, int low, int high) {
+    if (high <= low) return;
+    int depth = 2 * (std::bit_width((unsigned) (high - low + 1)) - 1);
+    introSortLoop(v, low, high, depth, compare);
+}
+
+template<Comparable T, Comparator<T> Compare>
+void pdqSort(std::vector<T> &v, Compare compare) {
+    if (v.size() < 2) return;
+    int badAllowed = std::bit_width(v.size()) - 1;
+    pdqSortLoop(v, 0, (int) v.size() - 1, badAllowed, true, compare);
+}
+
+template<Comparable T, Comparator<T> Compare>
+void timSort(std::vector<T> &v, Compare compare) {
+    TimSorter<T, Compare>(v, compare).sort(0, (int) v.size());
+}
+
+template<Comparable T, Comparator<T> Compare>
+void timSort(std::vector<T> &v, Compare compare, int low, int high) {
+    TimSorter<T, Compare>(v, compare).sort(low, high + 1);
+}
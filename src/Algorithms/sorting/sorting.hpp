@@ -13,15 +13,23 @@
 #include<vector>
 #include<functional>
 #include<random>
+#include<bit>
+#include<utility>
+#include<type_traits>
+#include<algorithm>
+#include<iterator>
 
 #include"../../Utils/comparable.hpp"
 #include"../../Utils/container.hpp"
+#include"../../Utils/comparator.hpp"
 #include"../../Data_structures/heap/heap.hpp"
 
 /** @namespace sorting
  *  @brief Predefined Standard Comparison Functions
  * 
- *  Template lambda functions for comparing elements in comparison sorts
+ *  Stateless comparison functors for comparing elements in comparison sorts. 
+ *  Being empty class types, the comparison is inlined into the sort instead of 
+ *  going through an indirect call.
  *  @param first 
  *  @param second
  *  @tparam T Data type of the elements to be compared
@@ -29,30 +37,79 @@
  */
 namespace sorting {
 
-    /** @brief Comparator for sorting in increasing order
+    /** @brief Comparator type for sorting in increasing order
      */
     template<typename T>
-        std::function<bool(T, T)> increasingOrder = [](const T &first, const T &second) {
-            return first > second;
+        struct IncreasingOrder {
+            constexpr bool operator()(const T &first, const T &second) const {
+                return first > second;
+            }
         };
 
-    /** @brief Comparator for sorting in decreasing order
+    /** @brief Comparator type for sorting in decreasing order
      */
     template<typename T>
-        std::function<bool(T, T)> decreasingOrder = [](const T &first, const T &second) {
-            return first < second;
+        struct DecreasingOrder {
+            constexpr bool operator()(const T &first, const T &second) const {
+                return first < second;
+            }
         };
 
-    /** @brief Comparator for sorting in order of increasing length.
+    /** @brief Comparator type for sorting in order of increasing length.
      *
      * Only valid for strings and other containers that have well defined sizes
      */
     template<OrderedContainer T>
-        std::function<bool(T, T)> lengthOrder = [](const T &first, const T &second) {
-            if (first.size() == second.size()) return first > second;
-            else return first.size() > second.size();
+        struct LengthOrder {
+            bool operator()(const T &first, const T &second) const {
+                if (first.size() == second.size()) return first > second;
+                else return first.size() > second.size();
+            }
         };
 
+    /** @brief Comparator for sorting in increasing order
+     */
+    template<typename T>
+        constexpr IncreasingOrder<T> increasingOrder{};
+
+    /** @brief Comparator for sorting in decreasing order
+     */
+    template<typename T>
+        constexpr DecreasingOrder<T> decreasingOrder{};
+
+    /** @brief Comparator for sorting in order of increasing length.
+     *
+     * Only valid for strings and other containers that have well defined sizes
+     */
+    template<OrderedContainer T>
+        constexpr LengthOrder<T> lengthOrder{};
+
+    /** @brief Subarrays of at most this many elements are finished with insertion sort by introSort()
+     */
+    const int INSERTION_SORT_THRESHOLD = 16;
+
+    /** @brief Subarrays larger than this use Tukey's ninther instead of the median of three as the pivot in introSort()
+     */
+    const int NINTHER_THRESHOLD = 128;
+
+    /** @brief Maximum number of element moves pdqSort() spends on finishing an already partitioned 
+     * subarray with insertion sort before falling back to partitioning it
+     */
+    const int PARTIAL_INSERTION_SORT_LIMIT = 8;
+
+    /** @brief Number of elements scanned per block by the branchless block partition of pdqSort()
+     */
+    const int BLOCK_PARTITION_SIZE = 64;
+
+    /** @brief Arrays shorter than this are sorted by timSort() with binary insertion sort, 
+     * also the upper bound of the minimum run length
+     */
+    const int MIN_MERGE = 64;
+
+    /** @brief Number of consecutive wins by one run after which timSort() switches to galloping
+     */
+    const int MIN_GALLOP = 7;
+
     /** @brief heapSort compareFlag for sorting in Increasing Order
      */
     const int HEAP_INCREASING = heap::MAX_HEAP;
@@ -74,10 +131,11 @@ namespace sorting {
  * @param low starting index of the subarray
  * @param high ending index of the subarray
  * @tparam T data type of the \a std::vector elements
+ * @tparam Compare type of the comparison callable
  * @return index of the pivot after partition
  */
-template<Comparable T>
-extern int partition(std::vector<T> &v, std::function<bool(T,T)> compare, int low, int high);
+template<Comparable T, Comparator<T> Compare>
+extern int partition(std::vector<T> &v, Compare compare, int low, int high);
 
 /**
  * @brief Randomised Partition function for Randomised Quick Sort
@@ -90,10 +148,29 @@ extern int partition(std::vector<T> &v, std::function<bool(T,T)> compare, int lo
  * @param low starting index of the subarray
  * @param high ending index of the subarray
  * @tparam T data type of the \a std::vector elements
+ * @tparam Compare type of the comparison callable
  * @return index of the pivot after partition
  */
-template<Comparable T>
-extern int randomisedPartition(std::vector<T> &v, std::function<bool(T,T)> compare, int low, int high);
+template<Comparable T, Comparator<T> Compare>
+extern int randomisedPartition(std::vector<T> &v, Compare compare, int low, int high);
+
+/**
+ * @brief Three-way Partition Function
+ *
+ * Dutch national flag partition of the subarray about the value of the last element. 
+ * Elements ordered before the pivot are moved to the front, elements equal to the pivot to 
+ * the middle and the rest to the back. \f$O(n)\f$
+ *
+ * @param v reference to the vector
+ * @param compare comparison function
+ * @param low starting index of the subarray
+ * @param high ending index of the subarray
+ * @tparam T data type of the \a std::vector elements
+ * @tparam Compare type of the comparison callable
+ * @return \a std::pair of the first and last index of the elements equal to the pivot
+ */
+template<Comparable T, Comparator<T> Compare>
+extern std::pair<int, int> threeWayPartition(std::vector<T> &v, Compare compare, int low, int high);
 
 /*
  * Sorting Algorithms
@@ -108,25 +185,29 @@ extern int randomisedPartition(std::vector<T> &v, std::function<bool(T,T)> compa
  * @param v reference of the vector to be sorted
  * @param compare comparison function
  * @tparam T data type of the \a std::vector elements
+ * @tparam Compare type of the comparison callable
  * @return none
  */
-template<Comparable T>
-extern void insertionSort(std::vector<T> &v, std::function<bool(T, T)> compare = sorting::increasingOrder<T>);
+template<Comparable T, Comparator<T> Compare = sorting::IncreasingOrder<T>>
+extern void insertionSort(std::vector<T> &v, Compare compare = Compare{});
 
 
 /**
  * @brief Merge Sort
  * 
  * Recursive implementation of the merge sort algorithm, increasing 
- * order by default. \f$O(n \log n)\f$
+ * order by default. Stable, the merges share a single buffer of \f$n/2\f$ 
+ * elements allocated once. Integer subarrays of at most @ref sorting::NETWORK_SORT_THRESHOLD 
+ * elements are sorted with networkSort(). \f$O(n \log n)\f$
  *
  * @param v reference of the vector to be sorted
  * @param compare comparison function
  * @tparam T data type of the \a std::vector elements
+ * @tparam Compare type of the comparison callable
  * @return none
  */
-template<Comparable T>
-extern void mergeSort(std::vector<T> &v, int compareFlag = sorting::increasingOrder<T>);
+template<Comparable T, Comparator<T> Compare = sorting::IncreasingOrder<T>>
+extern void mergeSort(std::vector<T> &v, Compare compare = Compare{});
 
 
 /**
@@ -148,16 +229,18 @@ extern void heapSort(std::vector<T> &v, int compareFlag = sorting::HEAP_INCREASI
 /**
  * @brief Quick Sort
  *
- * Quick Sort implementation, increasing order by default.
+ * Quick Sort implementation, increasing order by default. Arithmetic subarrays of at most 
+ * @ref sorting::NETWORK_SORT_THRESHOLD elements are sorted with networkSort().
  * \f$O(n \log n)\f$
  *
  * @param v reference of the vector to be sorted
  * @param compare comparison function
  * @tparam T data type of the \a std::vector elements
+ * @tparam Compare type of the comparison callable
  * @return none
  */
-template<Comparable T>
-extern void quickSort(std::vector<T> &v, std::function<bool(T, T)> compare = sorting::increasingOrder<T>);
+template<Comparable T, Comparator<T> Compare = sorting::IncreasingOrder<T>>
+extern void quickSort(std::vector<T> &v, Compare compare = Compare{});
 
 /**
  * @brief Randomised Quick Sort
@@ -168,10 +251,110 @@ extern void quickSort(std::vector<T> &v, std::function<bool(T, T)> compare = sor
  * @param v reference of the vector to be sorted
  * @param compare comparison function
  * @tparam T data type of the \a std::vector elements
+ * @tparam Compare type of the comparison callable
  * @return none
  */
-template<Comparable T>
-extern void randomisedQuickSort(std::vector<T> &v, std::function<bool(T,T)> compare = sorting::increasingOrder<T>);
+template<Comparable T, Comparator<T> Compare = sorting::IncreasingOrder<T>>
+extern void randomisedQuickSort(std::vector<T> &v, Compare compare = Compare{});
+
+/**
+ * @brief Intro Sort
+ *
+ * Quick Sort using a median of three (ninther for large subarrays) pivot, recursing only 
+ * on the smaller partition and switching to an in-place heap sort once the recursion depth 
+ * exceeds \f$2 \log_2 n\f$. Subarrays of at most @ref sorting::INSERTION_SORT_THRESHOLD 
+ * elements are finished with insertion sort. Increasing order by default.
+ *
+ * Sorted, reverse sorted and duplicate heavy inputs don't degrade the running time and the 
+ * stack depth is bounded by \f$O(\log n)\f$. Small arithmetic subarrays are finished with 
+ * networkSort() instead. \f$O(n \log n)\f$
+ *
+ * @param v reference of the vector to be sorted
+ * @param compare comparison function
+ * @tparam T data type of the \a std::vector elements
+ * @tparam Compare type of the comparison callable
+ * @return none
+ */
+template<Comparable T, Comparator<T> Compare = sorting::IncreasingOrder<T>>
+extern void introSort(std::vector<T> &v, Compare compare = Compare{});
+
+/**
+ * @brief Intro Sort on a subarray
+ *
+ * Sorts the subarray \a v[low..high] with introSort(). \f$O(n \log n)\f$
+ *
+ * @param v reference of the vector to be sorted
+ * @param compare comparison function
+ * @param low starting index of the subarray
+ * @param high ending index of the subarray
+ * @tparam T data type of the \a std::vector elements
+ * @tparam Compare type of the comparison callable
+ * @return none
+ */
+template<Comparable T, Comparator<T> Compare>
+extern void introSort(std::vector<T> &v, Compare compare, int low, int high);
+
+/**
+ * @brief Pattern Defeating Quick Sort
+ *
+ * Variant of introSort() that recognises patterns in the input:
+ * - Subarrays whose pivot equals the pivot of the parent partition contain a run of equal keys, 
+ *   which is partitioned out and never looked at again, so inputs with \f$k\f$ distinct 
+ *   values sort in \f$O(n \log k)\f$.
+ * - Partitions that needed no swaps are finished with a bounded insertion sort, so sorted 
+ *   and nearly sorted subarrays take linear time.
+ * - Highly unbalanced partitions shuffle a few elements to break adversarial patterns 
+ *   before falling back to heap sort.
+ *
+ * For arithmetic \a T with the @ref sorting comparators the partition is done branchlessly in 
+ * blocks of @ref sorting::BLOCK_PARTITION_SIZE elements. Increasing order by default. 
+ * \f$O(n \log n)\f$
+ *
+ * @param v reference of the vector to be sorted
+ * @param compare comparison function
+ * @tparam T data type of the \a std::vector elements
+ * @tparam Compare type of the comparison callable
+ * @return none
+ */
+template<Comparable T, Comparator<T> Compare = sorting::IncreasingOrder<T>>
+extern void pdqSort(std::vector<T> &v, Compare compare = Compare{});
+
+/**
+ * @brief Tim Sort
+ *
+ * Stable natural merge sort. Ascending and strictly descending runs already present in the 
+ * input are detected (descending ones reversed), short runs are extended with binary 
+ * insertion sort and runs are merged with galloping once one side keeps winning. Elements 
+ * are moved, never copied, through a single scratch buffer of at most \f$n/2\f$ elements 
+ * allocated once. Increasing order by default.
+ *
+ * \f$O(n)\f$ for presorted input, \f$O(n \log n)\f$ worst case.
+ *
+ * @param v reference of the vector to be sorted
+ * @param compare comparison function
+ * @tparam T data type of the \a std::vector elements
+ * @tparam Compare type of the comparison callable
+ * @return none
+ */
+template<Comparable T, Comparator<T> Compare = sorting::IncreasingOrder<T>>
+extern void timSort(std::vector<T> &v, Compare compare = Compare{});
+
+/**
+ * @brief Tim Sort on a subarray
+ *
+ * Sorts the subarray \a v[low..high] with timSort(), the scratch buffer is sized 
+ * by the subarray. \f$O(n \log n)\f$
+ *
+ * @param v reference of the vector to be sorted
+ * @param compare comparison function
+ * @param low starting index of the subarray
+ * @param high ending index of the subarray
+ * @tparam T data type of the \a std::vector elements
+ * @tparam Compare type of the comparison callable
+ * @return none
+ */
+template<Comparable T, Comparator<T> Compare>
+extern void timSort(std::vector<T> &v, Compare compare, int low, int high);
 
 #endif //ALGORITHMS_SORTING_HPP
 
@@ -0,0 +1,187 @@
+#include"./sorting_network.hpp"
+
+#if defined(__GNUC__) && !defined(__clang__) && (defined(__x86_64__) || defined(__i386__))
+#define DSA_SORTING_NETWORK_SIMD
+#endif
+
+namespace {
+
+    /*
+     * Value used to fill a block up to the network size, sorts after every element
+     */
+    template<NetworkSortable T>
+        constexpr T networkPadding() {
+            if constexpr (std::floating_point<T>) return std::numeric_limits<T>::infinity();
+            else return std::numeric_limits<T>::max();
+        }
+
+    /*
+     * Bitonic network on a[0..N) with branchless compare-exchanges
+     */
+    template<NetworkSortable T, int N>
+        void bitonicScalar(T *a) {
+            for (int k = 2; k <= N; k <<= 1) {
+                for (int j = k >> 1; j > 0; j >>= 1) {
+                    for (int i = 0; i < N; i++) {
+                        int l = i ^ j;
+                        if (l < i) continue;
+                        T lo = std::min(a[i], a[l]), hi = std::max(a[i], a[l]);
+                        bool ascending = (i & k) == 0;
+                        a[i] = ascending ? lo : hi;
+                        a[l] = ascending ? hi : lo;
+                    }
+                }
+            }
+        }
+
+    template<NetworkSortable T>
+        void networkSortScalar(T *data, int n) {
+            T block[sorting::NETWORK_SORT_THRESHOLD];
+            int size = 8;
+            while (size < n) size <<= 1;
+            std::copy(data, data + n, block);
+            std::fill(block + n, block + size, networkPadding<T>());
+            if (size == 8) bitonicScalar<T, 8>(block);
+            else if (size == 16) bitonicScalar<T, 16>(block);
+            else if (size == 32) bitonicScalar<T, 32>(block);
+            else bitonicScalar<T, 64>(block);
+            std::copy(block, block + n, data);
+        }
+
+#ifdef DSA_SORTING_NETWORK_SIMD
+    /*
+     * GCC vector extension types, Bytes wide registers of T and the matching lane index type
+     */
+    template<typename T, int Bytes> struct SimdTypes;
+
+    template<int Bytes> struct SimdTypes<int32_t, Bytes> {
+        typedef int32_t vector __attribute__((vector_size(Bytes)));
+        typedef int32_t index __attribute__((vector_size(Bytes)));
+        typedef int32_t lane;
+    };
+
+    template<int Bytes> struct SimdTypes<float, Bytes> {
+        typedef float vector __attribute__((vector_size(Bytes)));
+        typedef int32_t index __attribute__((vector_size(Bytes)));
+        typedef int32_t lane;
+    };
+
+    template<int Bytes> struct SimdTypes<int64_t, Bytes> {
+        typedef int64_t vector __attribute__((vector_size(Bytes)));
+        typedef int64_t index __attribute__((vector_size(Bytes)));
+        typedef int64_t lane;
+    };
+
+    template<int Bytes> struct SimdTypes<double, Bytes> {
+        typedef double vector __attribute__((vector_size(Bytes)));
+        typedef int64_t index __attribute__((vector_size(Bytes)));
+        typedef int64_t lane;
+    };
+
+    /*
+     * One (K, J) step of the bitonic network over N / L registers of L lanes. Element i = x * L + lane
+     * is compared with element i ^ J and keeps the minimum when (i & J == 0) == (i & K == 0).
+     * Steps with J >= L compare whole registers, the others shuffle lanes within a register
+     */
+    template<typename S, int L, int N, int K, int J, size_t... Lanes>
+        [[gnu::always_inline]] inline void bitonicStep(typename S::vector *r, std::index_sequence<Lanes...>) {
+            using V = typename S::vector;
+            using I = typename S::index;
+            using E = typename S::lane;
+            constexpr int R = N / L;
+            if constexpr (J >= L) {
+                constexpr int d = J / L;
+                for (int x = 0; x < R; x++) {
+                    if (x & d) continue;
+                    V lo = r[x] < r[x + d] ? r[x] : r[x + d];
+                    V hi = r[x] < r[x + d] ? r[x + d] : r[x];
+                    bool ascending = ((x * L) & K) == 0;
+                    r[x] = ascending ? lo : hi;
+                    r[x + d] = ascending ? hi : lo;
+                }
+            } else {
+                constexpr I partner = I{ (E) (Lanes ^ J)... };
+                // lanes taking the minimum for ascending and descending registers
+                constexpr I ascending = I{ (E) (((Lanes & J) == 0) ? Lanes : Lanes + L)... };
+                constexpr I descending = I{ (E) (((Lanes & J) != 0) ? Lanes : Lanes + L)... };
+                constexpr I byLane = I{ (E) ((((Lanes & J) == 0) == ((Lanes & K) == 0)) ? Lanes : Lanes + L)... };
+                for (int x = 0; x < R; x++) {
+                    V p = __builtin_shuffle(r[x], partner);
+                    V mn = r[x] < p ? r[x] : p;
+                    V mx = r[x] < p ? p : r[x];
+                    if constexpr (K < L) r[x] = __builtin_shuffle(mn, mx, byLane);
+                    else if (((x * L) & K) == 0) r[x] = __builtin_shuffle(mn, mx, ascending);
+                    else r[x] = __builtin_shuffle(mn, mx, descending);
+                }
+            }
+        }
+
+    template<typename S, int L, int N, int K, int J>
+        [[gnu::always_inline]] inline void bitonicStages(typename S::vector *r) {
+            if constexpr (K <= N) {
+                bitonicStep<S, L, N, K, J>(r, std::make_index_sequence<L>{});
+                if constexpr (J > 1) bitonicStages<S, L, N, K, J / 2>(r);
+                else bitonicStages<S, L, N, K * 2, K>(r);
+            }
+        }
+
+    /*
+     * Loads data[0..n) into N / L registers padded to N elements, sorts and stores back
+     */
+    template<NetworkSortable T, int Bytes, int N>
+        [[gnu::always_inline]] inline void bitonicSimd(T *data, int n) {
+            using S = SimdTypes<T, Bytes>;
+            constexpr int L = Bytes / sizeof(T);
+            typename S::vector r[N / L];
+            T block[N];
+            std::copy(data, data + n, block);
+            std::fill(block + n, block + N, networkPadding<T>());
+            std::memcpy(r, block, sizeof(block));
+            bitonicStages<S, L, N, 2, 1>(r);
+            std::memcpy(block, r, sizeof(block));
+            std::copy(block, block + n, data);
+        }
+
+    template<NetworkSortable T>
+        __attribute__((target("avx2"))) void networkSortAvx2(T *data, int n) {
+            if (n <= 8) bitonicSimd<T, 32, 8>(data, n);
+            else if (n <= 16) bitonicSimd<T, 32, 16>(data, n);
+            else if (n <= 32) bitonicSimd<T, 32, 32>(data, n);
+            else bitonicSimd<T, 32, 64>(data, n);
+        }
+
+    template<NetworkSortable T>
+        __attribute__((target("sse4.2"))) void networkSortSse4(T *data, int n) {
+            if (n <= 8) bitonicSimd<T, 16, 8>(data, n);
+            else if (n <= 16) bitonicSimd<T, 16, 16>(data, n);
+            else if (n <= 32) bitonicSimd<T, 16, 32>(data, n);
+            else bitonicSimd<T, 16, 64>(data, n);
+        }
+#endif
+
+    /*
+     * Picks the widest kernel supported by the CPU
+     */
+    template<NetworkSortable T>
+        auto chooseNetworkKernel() -> void (*)(T *, int) {
+#ifdef DSA_SORTING_NETWORK_SIMD
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx2")) return networkSortAvx2<T>;
+            if (__builtin_cpu_supports("sse4.2")) return networkSortSse4<T>;
+#endif
+            return networkSortScalar<T>;
+        }
+}
+
+template<NetworkSortable T, Comparator<T> Compare>
+    requires sorting::networkSortable<T, Compare>
+void networkSort(std::vector<T> &v, Compare, int low, int high) {
+    static const auto kernel = chooseNetworkKernel<T>();
+    int n = high - low + 1;
+    if (n > sorting::NETWORK_SORT_THRESHOLD) throw std::invalid_argument("Block too large for the sorting network");
+    if (n < 2) return;
+    kernel(v.data() + low, n);
+    if constexpr (std::same_as<Compare, sorting::DecreasingOrder<T>>) {
+        std::reverse(v.begin() + low, v.begin() + high + 1);
+    }
+}
@@ -0,0 +1,66 @@
+/**
+ * @file sorting_network.hpp
+ * @brief Sorting Networks
+ * @details Bitonic sorting network kernels for small blocks of arithmetic values, used as the 
+ * leaf sort of the comparison sorts.
+ * @author Atishek Kumar
+ * @date May 2021
+ */
+#ifndef ALGORITHMS_SORTING_NETWORK_HPP
+#define ALGORITHMS_SORTING_NETWORK_HPP
+
+#include<vector>
+#include<cstdint>
+#include<cstring>
+#include<stdexcept>
+#include<concepts>
+#include<limits>
+#include<utility>
+#include<algorithm>
+
+#include"sorting.hpp"
+
+/** @brief Network Sortable concept
+ * @details Element types with sorting network kernels
+ */
+template<typename T>
+concept NetworkSortable = std::same_as<T, int32_t> || std::same_as<T, int64_t> || 
+    std::same_as<T, float> || std::same_as<T, double>;
+
+namespace sorting {
+    /** @brief Largest block sorted by networkSort()
+     */
+    const int NETWORK_SORT_THRESHOLD = 64;
+
+    /** @brief Element and comparator combinations supported by networkSort()
+     */
+    template<typename T, typename Compare>
+        constexpr bool networkSortable = NetworkSortable<T> && 
+            (std::same_as<Compare, IncreasingOrder<T>> || std::same_as<Compare, DecreasingOrder<T>>);
+}
+
+/**
+ * @brief Sorting Network Sort
+ *
+ * Sorts a subarray of at most @ref sorting::NETWORK_SORT_THRESHOLD elements with a bitonic 
+ * sorting network of 8, 16, 32 or 64 elements, padding the block with the largest value of 
+ * \a T. The kernel is picked once at runtime: AVX2, SSE4.2, or a scalar network where neither 
+ * is available (or the compiler isn't GCC on x86).
+ *
+ * Not stable, equal keys are indistinguishable except for floating point \f$\pm 0\f$.
+ * \f$O(1)\f$
+ *
+ * @param v reference of the vector to be sorted
+ * @param compare sorting::increasingOrder or sorting::decreasingOrder
+ * @param low starting index of the subarray
+ * @param high ending index of the subarray
+ * @tparam T \a int32_t, \a int64_t, \a float or \a double
+ * @tparam Compare type of the comparison callable
+ * @exception std::invalid_argument - More than @ref sorting::NETWORK_SORT_THRESHOLD elements
+ * @return none
+ */
+template<NetworkSortable T, Comparator<T> Compare>
+    requires sorting::networkSortable<T, Compare>
+extern void networkSort(std::vector<T> &v, Compare compare, int low, int high);
+
+#endif //ALGORITHMS_SORTING_NETWORK_HPP
@@ -0,0 +1,222 @@
+#include"streaming_statistics.hpp"
+
+/* ====================================== KLL Sketch ====================================== */
+
+template<Comparable T>
+KLLSketch<T>::KLLSketch(int k, uint64_t seed) : k(k), state(seed | 1) {
+    if(k < 2) throw std::invalid_argument("k less than 2");
+    levels.emplace_back();
+    limit = capacity(0);
+}
+
+template<Comparable T>
+int KLLSketch<T>::capacity(int level) const {
+    int height = (int) levels.size();
+    return std::max(2, (int) std::ceil(k * std::pow(2.0 / 3.0, height - 1 - level)));
+}
+
+template<Comparable T>
+void KLLSketch<T>::compress() {
+    while(items > limit) {
+        for(int h = 0; h < (int) levels.size(); h++) {
+            if((int) levels[h].size() < capacity(h)) continue;
+            if(h + 1 == (int) levels.size()) {
+                levels.emplace_back();
+                limit = 0;
+                for(int level = 0; level < (int) levels.size(); level++) {
+                    limit += capacity(level);
+                }
+            }
+            auto &level = levels[h];
+            pdqSort(level);
+            // xorshift, the offset decides which half is promoted
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            // an odd item stays behind so that the weights still add up to n
+            size_t keep = level.size() % 2;
+            for(size_t i = keep + (state & 1); i < level.size(); i += 2) {
+                levels[h + 1].push_back(level[i]);
+            }
+            items -= (level.size() - keep) / 2;
+            level.resize(keep);
+            break;
+        }
+    }
+}
+
+template<Comparable T>
+void KLLSketch<T>::insert(const T &value) {
+    if(n == 0 || value < minimum) minimum = value;
+    if(n == 0 || value > maximum) maximum = value;
+    levels[0].push_back(value);
+    n++;
+    items++;
+    if(items > limit) compress();
+}
+
+template<Comparable T>
+void KLLSketch<T>::merge(const KLLSketch &other) {
+    if(other.n == 0) return;
+    if(n == 0 || other.minimum < minimum) minimum = other.minimum;
+    if(n == 0 || other.maximum > maximum) maximum = other.maximum;
+    while(levels.size() < other.levels.size()) {
+        levels.emplace_back();
+    }
+    for(size_t h = 0; h < other.levels.size(); h++) {
+        levels[h].insert(levels[h].end(), other.levels[h].begin(), other.levels[h].end());
+    }
+    n += other.n;
+    items += other.items;
+    limit = 0;
+    for(int level = 0; level < (int) levels.size(); level++) {
+        limit += capacity(level);
+    }
+    compress();
+}
+
+template<Comparable T>
+double KLLSketch<T>::rank(const T &value) const {
+    if(n == 0) throw std::runtime_error("Empty sketch");
+    size_t weight = 0;
+    for(size_t h = 0; h < levels.size(); h++) {
+        for(const auto& item: levels[h]) {
+            if(!(value < item)) weight += size_t(1) << h;
+        }
+    }
+    return (double) weight / n;
+}
+
+template<Comparable T>
+T KLLSketch<T>::quantile(double q) const {
+    if(n == 0) throw std::runtime_error("Empty sketch");
+    if(!(q >= 0 && q <= 1)) throw std::out_of_range("Invalid quantile");
+    if(q == 0) return minimum;
+    if(q == 1) return maximum;
+    std::vector<std::pair<T, size_t>> weighted;
+    weighted.reserve(items);
+    for(size_t h = 0; h < levels.size(); h++) {
+        for(const auto& item: levels[h]) {
+            weighted.emplace_back(item, size_t(1) << h);
+        }
+    }
+    pdqSort(weighted);
+    double target = q * n, cumulative = 0;
+    for(const auto& [item, weight]: weighted) {
+        cumulative += weight;
+        if(cumulative >= target) return item;
+    }
+    return maximum;
+}
+
+/* ====================================== T-Digest ====================================== */
+
+template<std::floating_point T>
+TDigest<T>::TDigest(double compression) : compression(compression) {
+    if(!(compression >= 1)) throw std::invalid_argument("compression less than 1");
+    buffer.reserve((size_t) (streaming_statistics::TDIGEST_BUFFER_FACTOR * compression));
+}
+
+template<std::floating_point T>
+void TDigest<T>::flush() const {
+    if(buffer.empty()) return;
+    buffer.insert(buffer.end(), centroids.begin(), centroids.end());
+    std::sort(buffer.begin(), buffer.end(), [](const Centroid &first, const Centroid &second) {
+        return first.mean < second.mean;
+    });
+    centroids.clear();
+
+    // k1 scale function, a centroid spans at most one unit of k
+    auto scale = [this](double q) { return compression / (2 * std::numbers::pi) * std::asin(2 * q - 1); };
+    auto limitAfter = [this, &scale](double q) {
+        double k = scale(q) + 1;
+        return k >= compression / 4 ? 1.0 : (std::sin(k * 2 * std::numbers::pi / compression) + 1) / 2;
+    };
+    double soFar = 0, limit = limitAfter(0);
+    Centroid current = buffer[0];
+    for(size_t i = 1; i < buffer.size(); i++) {
+        const Centroid &next = buffer[i];
+        if((soFar + current.weight + next.weight) / total <= limit) {
+            current.weight += next.weight;
+            current.mean += (next.mean - current.mean) * (T) (next.weight / current.weight);
+        } else {
+            soFar += current.weight;
+            centroids.push_back(current);
+            limit = limitAfter(soFar / total);
+            current = next;
+        }
+    }
+    centroids.push_back(current);
+    buffer.clear();
+}
+
+template<std::floating_point T>
+void TDigest<T>::insert(T value, double weight) {
+    if(std::isnan(value)) throw std::invalid_argument("NaN value");
+    if(!(weight > 0)) throw std::invalid_argument("Weight isn't positive");
+    if(total == 0 || value < minimum) minimum = value;
+    if(total == 0 || value > maximum) maximum = value;
+    buffer.push_back({value, weight});
+    total += weight;
+    if(buffer.size() >= streaming_statistics::TDIGEST_BUFFER_FACTOR * compression) flush();
+}
+
+template<std::floating_point T>
+void TDigest<T>::merge(const TDigest &other) {
+    if(other.total == 0) return;
+    other.flush();
+    if(total == 0 || other.minimum < minimum) minimum = other.minimum;
+    if(total == 0 || other.maximum > maximum) maximum = other.maximum;
+    buffer.insert(buffer.end(), other.centroids.begin(), other.centroids.end());
+    total += other.total;
+    flush();
+}
+
+template<std::floating_point T>
+size_t TDigest<T>::retained() const {
+    flush();
+    return centroids.size();
+}
+
+template<std::floating_point T>
+double TDigest<T>::rank(T value) const {
+    if(total == 0) throw std::runtime_error("Empty digest");
+    if(value < minimum) return 0;
+    if(value >= maximum) return 1;
+    flush();
+    // centroid i is centred on the cumulative weight before it plus half its weight
+    double before = 0;
+    T previous = minimum;
+    double previousRank = 0;
+    for(const auto& centroid: centroids) {
+        double centre = before + centroid.weight / 2;
+        if(value < centroid.mean) {
+            return (previousRank + (centre - previousRank) * (value - previous) / (centroid.mean - previous)) / total;
+        }
+        before += centroid.weight;
+        previous = centroid.mean;
+        previousRank = centre;
+    }
+    return (previousRank + (total - previousRank) * (value - previous) / (maximum - previous)) / total;
+}
+
+template<std::floating_point T>
+T TDigest<T>::quantile(double q) const {
+    if(total == 0) throw std::runtime_error("Empty digest");
+    if(!(q >= 0 && q <= 1)) throw std::out_of_range("Invalid quantile");
+    if(q == 0) return minimum;
+    if(q == 1) return maximum;
+    flush();
+    double index = q * total, before = 0, previousRank = 0;
+    T previous = minimum;
+    for(const auto& centroid: centroids) {
+        double centre = before + centroid.weight / 2;
+        if(index < centre) {
+            return previous + (centroid.mean - previous) * (T) ((index - previousRank) / (centre - previousRank));
+        }
+        before += centroid.weight;
+        previous = centroid.mean;
+        previousRank = centre;
+    }
+    return previous + (maximum - previous) * (T) ((index - previousRank) / (total - previousRank));
+}
@@ -0,0 +1,215 @@
+/** @file streaming_statistics.hpp
+ * @brief Streaming Statistics
+ * @details Quantile sketches answering approximate order statistics over unbounded streams in 
+ * bounded memory, the streaming counterpart of the exact selection of order_statistics.hpp. 
+ * Sketches of the same parameters can be merged, e.g. to combine per-thread sketches.
+ * @author Atishek Kumar
+ * @date May 2021
+ * @warning Not thread safe, use one sketch per thread and merge them
+ */
+#ifndef ALGORITHMS_STREAMING_STATISTICS_HPP
+#define ALGORITHMS_STREAMING_STATISTICS_HPP
+
+#include<vector>
+#include<cstdint>
+#include<cmath>
+#include<numbers>
+#include<stdexcept>
+#include<algorithm>
+#include<concepts>
+
+#include"../sorting/sorting.hpp"
+#include"../../Utils/comparable.hpp"
+
+/**@namespace streaming_statistics
+ * @brief Streaming statistics constants
+ */
+namespace streaming_statistics {
+    /** @brief Default size of the top compactor of KLLSketch
+     */
+    const int KLL_DEFAULT_K = 200;
+    /** @brief Default compression of TDigest, roughly the number of centroids kept
+     */
+    const double TDIGEST_DEFAULT_COMPRESSION = 100;
+    /** @brief Values buffered by TDigest per unit of compression before they're merged
+     */
+    const int TDIGEST_BUFFER_FACTOR = 5;
+}
+
+/**
+ * @brief KLL Quantile Sketch
+ * @details Karnin-Lang-Liberty sketch. Values are kept in a hierarchy of compactors, the items of 
+ * level \a h weigh \f$2^h\f$. A full compactor is sorted and every other item, starting at a 
+ * random offset, is promoted to the next level. The capacity of level \a h of \a H levels is 
+ * \f$k (2/3)^{H - 1 - h}\f$, at least 2, so the sketch keeps \f$O(k)\f$ items and the rank error 
+ * is about \f$1.7 / k\f$ with high probability, independent of the distribution of the values.
+ *
+ * Works for any comparable type, the minimum and maximum are exact.
+ * @tparam T Data type of the values
+ */
+template<Comparable T>
+class KLLSketch {
+    private:
+        std::vector<std::vector<T>> levels{};
+        int k;
+        size_t n = 0;
+        size_t items = 0;
+        size_t limit = 0;
+        uint64_t state;
+        T minimum{}, maximum{};
+
+        /* Private Functions */
+
+        int capacity(int level) const;
+
+        void compress();
+
+    public:
+        /**
+         * @brief Constructor
+         * @param k size of the top compactor, accuracy against memory
+         * @param seed seed of the compaction offsets
+         * @exception std::invalid_argument - \a k less than 2
+         */
+        explicit KLLSketch(int k = streaming_statistics::KLL_DEFAULT_K, uint64_t seed = 0x9e3779b97f4a7c15ull);
+
+        /**
+         * @brief Insert a value
+         * @details Amortised \f$O(\log k)\f$
+         * @param value value of the stream
+         */
+        void insert(const T &value);
+
+        /**
+         * @brief Merge a sketch
+         * @details Adds the values summarised by \a other, the sketches should have the same \a k
+         * @param other sketch to be merged into this one
+         */
+        void merge(const KLLSketch &other);
+
+        /**
+         * @brief Number of values inserted
+         * @return \b size_t count of the stream
+         */
+        size_t count() const noexcept {
+            return n;
+        }
+
+        /**
+         * @brief Number of values kept
+         * @return \b size_t items in the compactors
+         */
+        size_t retained() const noexcept {
+            return items;
+        }
+
+        /**
+         * @brief Normalised rank
+         * @details Approximate fraction of the values less than or equal to \a value
+         * @param value value to be ranked
+         * @return \b double in \f$[0, 1]\f$
+         * @exception std::runtime_error - When the sketch is empty
+         */
+        double rank(const T &value) const;
+
+        /**
+         * @brief Quantile
+         * @details Approximate value whose normalised rank is \a q, \a 0 and \a 1 give the exact 
+         * minimum and maximum
+         * @param q fraction in \f$[0, 1]\f$
+         * @return \b T value of the quantile
+         * @exception std::runtime_error - When the sketch is empty
+         * @exception std::out_of_range - \a q outside of \f$[0, 1]\f$
+         */
+        T quantile(double q) const;
+};
+
+/**
+ * @brief T-Digest
+ * @details Merging t-digest of Dunning. The stream is summarised by centroids (mean, weight) 
+ * sorted by mean, incoming values are buffered and merged in one sorted pass. The k1 scale 
+ * function \f$k(q) = \frac{\delta}{2\pi} \arcsin(2q - 1)\f$ limits every centroid to one unit of 
+ * \a k, so the centroids near the tails hold few values and the extreme quantiles, e.g. the 
+ * 99.9th percentile of latencies, are much more accurate than the median.
+ *
+ * Keeps at most about \f$\delta\f$ centroids plus the buffer.
+ * @tparam T Data type of the values - Should be floating point
+ */
+template<std::floating_point T>
+class TDigest {
+    private:
+        struct Centroid {
+            T mean;
+            double weight;
+        };
+
+        mutable std::vector<Centroid> centroids{};
+        mutable std::vector<Centroid> buffer{};
+        double compression;
+        double total = 0;
+        T minimum{}, maximum{};
+
+        /* Private Functions */
+
+        void flush() const;
+
+    public:
+        /**
+         * @brief Constructor
+         * @param compression \f$\delta\f$, accuracy against memory
+         * @exception std::invalid_argument - \a compression less than 1
+         */
+        explicit TDigest(double compression = streaming_statistics::TDIGEST_DEFAULT_COMPRESSION);
+
+        /**
+         * @brief Insert a value
+         * @details Amortised \f$O(\log \delta)\f$
+         * @param value value of the stream
+         * @param weight number of occurrences of \a value
+         */
+        void insert(T value, double weight = 1);
+
+        /**
+         * @brief Merge a digest
+         * @details Adds the centroids of \a other
+         * @param other digest to be merged into this one
+         */
+        void merge(const TDigest &other);
+
+        /**
+         * @brief Number of values inserted
+         * @return \b double total weight of the stream
+         */
+        double count() const noexcept {
+            return total;
+        }
+
+        /**
+         * @brief Number of centroids kept
+         * @return \b size_t centroids after merging the buffer
+         */
+        size_t retained() const;
+
+        /**
+         * @brief Normalised rank
+         * @details Approximate fraction of the values less than or equal to \a value, interpolated 
+         * between the centroids
+         * @param value value to be ranked
+         * @return \b double in \f$[0, 1]\f$
+         * @exception std::runtime_error - When the digest is empty
+         */
+        double rank(T value) const;
+
+        /**
+         * @brief Quantile
+         * @details Approximate value whose normalised rank is \a q, interpolated between the 
+         * centroids, \a 0 and \a 1 give the exact minimum and maximum
+         * @param q fraction in \f$[0, 1]\f$
+         * @return \b T value of the quantile
+         * @exception std::runtime_error - When the digest is empty
+         * @exception std::out_of_range - \a q outside of \f$[0, 1]\f$
+         */
+        T quantile(double q) const;
+};
+
+#endif //ALGORITHMS_STREAMING_STATISTICS_HPP
@@ -0,0 +1,376 @@
+#include"flat_hash_map.hpp"
+
+#if defined(__SSE2__)
+#define DSA_FLAT_HASH_MAP_SSE2
+#include<emmintrin.h>
+#endif
+
+// Private Functions
+
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+size_t FlatHashMap<Key, Data, Hash>::hash(const lookup_key_t<Key> &key) const {
+    return hasher(key);
+}
+
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+void FlatHashMap<Key, Data, Hash>::set_ctrl(size_t i, int8_t value) {
+    ctrl[i] = value;
+    if(i < GROUP_WIDTH) ctrl[capacity + i] = value;
+}
+
+/*
+ * Bit g of the masks is set when slot i + g of the group starting at slot i matches
+ */
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+uint32_t FlatHashMap<Key, Data, Hash>::match(size_t i, int8_t fragment) const {
+#ifdef DSA_FLAT_HASH_MAP_SSE2
+    __m128i group = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl + i));
+    return (uint32_t) _mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8(fragment)));
+#else
+    uint32_t mask = 0;
+    for(size_t g = 0; g < GROUP_WIDTH; g++) {
+        mask |= (uint32_t) (ctrl[i + g] == fragment) << g;
+    }
+    return mask;
+#endif
+}
+
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+uint32_t FlatHashMap<Key, Data, Hash>::match_empty(size_t i) const {
+    return match(i, EMPTY);
+}
+
+/*
+ * EMPTY and DELETED are the only negative control bytes
+ */
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+uint32_t FlatHashMap<Key, Data, Hash>::match_free(size_t i) const {
+#ifdef DSA_FLAT_HASH_MAP_SSE2
+    return (uint32_t) _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl + i)));
+#else
+    uint32_t mask = 0;
+    for(size_t g = 0; g < GROUP_WIDTH; g++) {
+        mask |= (uint32_t) (ctrl[i + g] < 0) << g;
+    }
+    return mask;
+#endif
+}
+
+/*
+ * Slot of the key, capacity when it isn't there. The probe stops at the first group with an empty
+ * slot since an insert would have used it
+ */
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+size_t FlatHashMap<Key, Data, Hash>::find_index(const lookup_key_t<Key> &key, size_t hash_val) const {
+    if(capacity == 0) return 0;
+    size_t mask = capacity - 1;
+    int8_t fragment = (int8_t) (hash_val & 0x7f);
+    for(size_t i = (hash_val >> 7) & mask, step = GROUP_WIDTH; ; i = (i + step) & mask, step += GROUP_WIDTH) {
+        for(uint32_t hits = match(i, fragment); hits != 0; hits &= hits - 1) {
+            size_t slot = (i + __builtin_ctz(hits)) & mask;
+            if(slots[slot].first == key) return slot;
+        }
+        if(match_empty(i) != 0) return capacity;
+    }
+}
+
+/*
+ * First empty or deleted slot of the probe sequence
+ */
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+size_t FlatHashMap<Key, Data, Hash>::find_free(size_t hash_val) const {
+    size_t mask = capacity - 1;
+    for(size_t i = (hash_val >> 7) & mask, step = GROUP_WIDTH; ; i = (i + step) & mask, step += GROUP_WIDTH) {
+        uint32_t free = match_free(i);
+        if(free != 0) return (i + __builtin_ctz(free)) & mask;
+    }
+}
+
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+void FlatHashMap<Key, Data, Hash>::allocate(size_t new_capacity) {
+    try {
+        ctrl = new int8_t[new_capacity + GROUP_WIDTH];
+        try {
+            slots = std::allocator<Slot>().allocate(new_capacity);
+        } catch(const std::bad_alloc& e) {
+            delete[] ctrl;
+            throw;
+        }
+    } catch(const std::bad_alloc& e) {
+        ctrl = nullptr;
+        slots = nullptr;
+        capacity = growth_left = 0;
+        throw std::runtime_error("Unable to allocate the table");
+    }
+    std::memset(ctrl, EMPTY, new_capacity + GROUP_WIDTH);
+    capacity = new_capacity;
+    growth_left = max_load(new_capacity);
+}
+
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+void FlatHashMap<Key, Data, Hash>::deallocate() {
+    if(ctrl == nullptr) return;
+    clear();
+    delete[] ctrl;
+    std::allocator<Slot>().deallocate(slots, capacity);
+    ctrl = nullptr;
+    slots = nullptr;
+    capacity = growth_left = 0;
+}
+
+/*
+ * Moves every entry to a fresh table of new_capacity slots, which also drops the tombstones
+ */
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+void FlatHashMap<Key, Data, Hash>::rehash(size_t new_capacity) {
+    int8_t* old_ctrl = ctrl;
+    Slot* old_slots = slots;
+    size_t old_capacity = capacity, old_growth_left = growth_left;
+    try {
+        allocate(new_capacity);
+    } catch(const std::runtime_error& e) {
+        ctrl = old_ctrl;
+        slots = old_slots;
+        capacity = old_capacity;
+        growth_left = old_growth_left;
+        throw std::runtime_error("Unable to resize the table");
+    }
+    for(size_t i = 0; i < old_capacity; i++) {
+        if(old_ctrl[i] < 0) continue;
+        size_t hash_val = hash(old_slots[i].first);
+        size_t slot = find_free(hash_val);
+        std::construct_at(slots + slot, std::move(old_slots[i]));
+        std::destroy_at(old_slots + i);
+        set_ctrl(slot, (int8_t) (hash_val & 0x7f));
+    }
+    growth_left -= _size;
+    if(old_ctrl != nullptr) {
+        delete[] old_ctrl;
+        std::allocator<Slot>().deallocate(old_slots, old_capacity);
+    }
+}
+
+/*
+ * The slot can go back to EMPTY when no window of GROUP_WIDTH slots around it was ever full, else a
+ * probe may have passed over it and it has to stay a tombstone
+ */
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+void FlatHashMap<Key, Data, Hash>::erase_at(size_t i) {
+    std::destroy_at(slots + i);
+    _size--;
+    size_t before = (i - GROUP_WIDTH) & (capacity - 1);
+    uint32_t empty_after = match_empty(i), empty_before = match_empty(before);
+    bool never_full = empty_after != 0 && empty_before != 0 &&
+                      (size_t) (__builtin_ctz(empty_after) + __builtin_clz(empty_before) - 16) < GROUP_WIDTH;
+    if(never_full) {
+        set_ctrl(i, EMPTY);
+        growth_left++;
+    } else {
+        set_ctrl(i, DELETED);
+    }
+}
+
+/*
+ * Constructs the entry of a key known to be absent. When the table is out of fresh slots it is
+ * rebuilt at the same capacity if at most half the load is live entries, the rest being tombstones,
+ * else at twice the capacity
+ */
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+template<typename... Args>
+size_t FlatHashMap<Key, Data, Hash>::emplace_new(size_t hash_val, Args&&... args) {
+    if(growth_left == 0) {
+        if(capacity == 0) rehash(GROUP_WIDTH);
+        else rehash(_size <= max_load(capacity) / 2 ? capacity : capacity * 2);
+    }
+    size_t slot = find_free(hash_val);
+    std::construct_at(slots + slot, std::forward<Args>(args)...);
+    if(ctrl[slot] == EMPTY) growth_left--;
+    set_ctrl(slot, (int8_t) (hash_val & 0x7f));
+    _size++;
+    return slot;
+}
+
+// Constructors and Destructors
+
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+FlatHashMap<Key, Data, Hash>::FlatHashMap(size_t capacity, Hash hasher) : hasher(std::move(hasher)) {
+    size_t slots_needed = GROUP_WIDTH;
+    while(max_load(slots_needed) < capacity) slots_needed *= 2;
+    allocate(slots_needed);
+}
+
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+FlatHashMap<Key, Data, Hash>::FlatHashMap(const FlatHashMap &other) : hasher(other.hasher) {
+    if(other.capacity == 0) return;
+    allocate(other.capacity);
+    size_t i = 0;
+    try {
+        for(; i < capacity; i++) {
+            if(other.ctrl[i] >= 0) std::construct_at(slots + i, other.slots[i]);
+        }
+    } catch(...) {
+        while(i-- > 0) {
+            if(other.ctrl[i] >= 0) std::destroy_at(slots + i);
+        }
+        delete[] ctrl;
+        std::allocator<Slot>().deallocate(slots, capacity);
+        throw;
+    }
+    std::memcpy(ctrl, other.ctrl, capacity + GROUP_WIDTH);
+    _size = other._size;
+    growth_left = other.growth_left;
+}
+
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+FlatHashMap<Key, Data, Hash>::FlatHashMap(FlatHashMap &&other) noexcept :
+    ctrl(std::exchange(other.ctrl, nullptr)), slots(std::exchange(other.slots, nullptr)), hasher(other.hasher),
+    capacity(std::exchange(other.capacity, 0)), _size(std::exchange(other._size, 0)),
+    growth_left(std::exchange(other.growth_left, 0)) {}
+
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+FlatHashMap<Key, Data, Hash>& FlatHashMap<Key, Data, Hash>::operator=(FlatHashMap other) noexcept {
+    std::swap(ctrl, other.ctrl);
+    std::swap(slots, other.slots);
+    std::swap(hasher, other.hasher);
+    std::swap(capacity, other.capacity);
+    std::swap(_size, other._size);
+    std::swap(growth_left, other.growth_left);
+    return *this;
+}
+
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+FlatHashMap<Key, Data, Hash>::~FlatHashMap() {
+    deallocate();
+}
+
+// Operations
+
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+void FlatHashMap<Key, Data, Hash>::clear() noexcept {
+    if(ctrl == nullptr) return;
+    for(size_t i = 0; i < capacity; i++) {
+        if(ctrl[i] >= 0) std::destroy_at(slots + i);
+    }
+    std::memset(ctrl, EMPTY, capacity + GROUP_WIDTH);
+    _size = 0;
+    growth_left = max_load(capacity);
+}
+
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+void FlatHashMap<Key, Data, Hash>::reserve(size_t count) {
+    if(capacity != 0 && count <= _size + growth_left) return;
+    size_t slots_needed = std::max(capacity, GROUP_WIDTH);
+    while(max_load(slots_needed) < count) slots_needed *= 2;
+    rehash(slots_needed);
+}
+
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+bool FlatHashMap<Key, Data, Hash>::contains_key(const lookup_key_t<Key> &key) const noexcept {
+    return find_index(key, hash(key)) != capacity;
+}
+
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+bool FlatHashMap<Key, Data, Hash>::insert(Key key, Data data) {
+    size_t hash_val = hash(key);
+    if(find_index(key, hash_val) != capacity) return false;
+    emplace_new(hash_val, std::move(key), std::move(data));
+    return true;
+}
+
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+bool FlatHashMap<Key, Data, Hash>::insert(std::pair<Key, Data> element) {
+    return insert(std::move(element.first), std::move(element.second));
+}
+
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+std::optional<Data> FlatHashMap<Key, Data, Hash>::get(const lookup_key_t<Key> &key) const {
+    size_t slot = find_index(key, hash(key));
+    if(slot == capacity) return std::nullopt;
+    return std::optional<Data>{slots[slot].second};
+}
+
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+std::optional<Data> FlatHashMap<Key, Data, Hash>::remove(const lookup_key_t<Key> &key) {
+    size_t slot = find_index(key, hash(key));
+    if(slot == capacity) return std::nullopt;
+    std::optional<Data> ret{std::move(slots[slot].second)};
+    erase_at(slot);
+    return ret;
+}
+
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+bool FlatHashMap<Key, Data, Hash>::update(const lookup_key_t<Key> &key, Data new_data) {
+    size_t slot = find_index(key, hash(key));
+    if(slot == capacity) return false;
+    slots[slot].second = std::move(new_data);
+    return true;
+}
+
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+Data* FlatHashMap<Key, Data, Hash>::find(const lookup_key_t<Key> &key) noexcept {
+    size_t slot = find_index(key, hash(key));
+    return slot == capacity ? nullptr : &slots[slot].second;
+}
+
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+const Data* FlatHashMap<Key, Data, Hash>::find(const lookup_key_t<Key> &key) const noexcept {
+    size_t slot = find_index(key, hash(key));
+    return slot == capacity ? nullptr : &slots[slot].second;
+}
+
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+template<typename... Args>
+std::pair<Data*, bool> FlatHashMap<Key, Data, Hash>::try_emplace(const lookup_key_t<Key> &key, Args&&... args) {
+    size_t hash_val = hash(key);
+    size_t slot = find_index(key, hash_val);
+    if(slot != capacity) return {&slots[slot].second, false};
+    slot = emplace_new(hash_val, std::piecewise_construct, std::forward_as_tuple(key),
+                       std::forward_as_tuple(std::forward<Args>(args)...));
+    return {&slots[slot].second, true};
+}
+
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+template<typename... Args>
+std::pair<Data*, bool> FlatHashMap<Key, Data, Hash>::emplace(Args&&... args) {
+    Slot entry(std::forward<Args>(args)...);
+    size_t hash_val = hash(entry.first);
+    size_t slot = find_index(entry.first, hash_val);
+    if(slot != capacity) return {&slots[slot].second, false};
+    slot = emplace_new(hash_val, std::move(entry));
+    return {&slots[slot].second, true};
+}
+
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+Data& FlatHashMap<Key, Data, Hash>::operator[](const lookup_key_t<Key> &key) {
+    return *try_emplace(key).first;
+}
+
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+std::vector<std::pair<Key, Data>> FlatHashMap<Key, Data, Hash>::key_value() const {
+    std::vector<std::pair<Key, Data>> entries;
+    entries.reserve(_size);
+    for(size_t i = 0; i < capacity; i++) {
+        if(ctrl[i] >= 0) entries.push_back(slots[i]);
+    }
+    return entries;
+}
+
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+std::vector<Key> FlatHashMap<Key, Data, Hash>::keys() const {
+    std::vector<Key> entries;
+    entries.reserve(_size);
+    for(size_t i = 0; i < capacity; i++) {
+        if(ctrl[i] >= 0) entries.push_back(slots[i].first);
+    }
+    return entries;
+}
+
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+std::vector<Data> FlatHashMap<Key, Data, Hash>::values() const {
+    std::vector<Data> entries;
+    entries.reserve(_size);
+    for(size_t i = 0; i < capacity; i++) {
+        if(ctrl[i] >= 0) entries.push_back(slots[i].second);
+    }
+    return entries;
+}
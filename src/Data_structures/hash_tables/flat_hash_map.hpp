@@ -0,0 +1,284 @@
+/**@file flat_hash_map.hpp
+ * @brief Generic flat Hash Map with SIMD probed control bytes
+ * @details FlatHashMap template class implementing a Swiss table: open addressing over a power of two
+ * array of slots with a separate array of control bytes matched a group at a time
+ * @author atishek22 <kumaratishek22@gmail.com>
+ * @date Jul 2021
+ * @warning Not thread safe
+ */
+
+#ifndef DATA_STRUCTURES_FLAT_HASH_MAP_HPP
+#define DATA_STRUCTURES_FLAT_HASH_MAP_HPP
+
+#include<stdexcept>
+#include<functional>
+#include<cstdint>
+#include<cstring>
+#include<memory>
+#include<optional>
+#include<tuple>
+#include<utility>
+#include<vector>
+
+#include"../../Utils/hashable.hpp"
+#include"../../Utils/hash.hpp"
+
+/**@brief FlatHashMap Template Class
+ * @details Hash map storing the entries inline in one array of slots. Every slot has a control byte,
+ * \a EMPTY, \a DELETED or the 7 low bits of the hash of its key when full. The remaining bits of the
+ * hash pick the first group of @ref GROUP_WIDTH slots of the probe sequence, a lookup compares the
+ * control bytes of a whole group with the 7 bit fragment in one SSE2 instruction and only compares
+ * the keys of the matching slots, about one in 128 of the others. The probe moves to the next group
+ * in triangular steps until a group with an empty slot is found.
+ *
+ * The capacity is a power of two, the table grows when it would be more than 7/8 full counting the
+ * tombstones. A removed slot becomes \a EMPTY when its group never filled up, else a \a DELETED
+ * tombstone which inserts reuse.
+ *
+ * @tparam Key Hashable Key data type
+ * @tparam Data Type of data to be stored by the table
+ * @tparam Hash Hash function of the keys and their lookup type, see \a hashing::WyHash
+ *
+ * @warning Not thread safe
+ */
+template<typename Key, typename Data, KeyHasher<Key> Hash = hashing::WyHash>
+class FlatHashMap {
+
+public:
+    /**@brief Slots compared by one group match */
+    static constexpr size_t GROUP_WIDTH = 16;
+
+private:
+    static constexpr size_t DEFAULT_CAPACITY = 16;
+    static constexpr int8_t EMPTY = -128;
+    static constexpr int8_t DELETED = -2;
+
+    using Slot = std::pair<Key, Data>;
+
+    /*
+     * capacity control bytes followed by a copy of the first GROUP_WIDTH ones so that a group can be
+     * loaded at any index
+     */
+    int8_t* ctrl = nullptr;
+    Slot* slots = nullptr;
+    Hash hasher;
+    size_t capacity = 0, _size = 0, growth_left = 0;
+
+    /* Private Functions */
+
+    size_t hash(const lookup_key_t<Key> &key) const;
+
+    static size_t max_load(size_t capacity) {
+        return capacity - capacity / 8;
+    }
+
+    void set_ctrl(size_t i, int8_t value);
+
+    uint32_t match(size_t i, int8_t fragment) const;
+
+    uint32_t match_empty(size_t i) const;
+
+    uint32_t match_free(size_t i) const;
+
+    size_t find_index(const lookup_key_t<Key> &key, size_t hash_val) const;
+
+    size_t find_free(size_t hash_val) const;
+
+    void allocate(size_t capacity);
+
+    void deallocate();
+
+    void rehash(size_t new_capacity);
+
+    void erase_at(size_t i);
+
+    template<typename... Args>
+    size_t emplace_new(size_t hash_val, Args&&... args);
+
+public:
+    /**@brief Default constructor
+     * @details Creates an empty table with room for \a capacity elements before it grows
+     * @param capacity Number of elements the table holds without growing
+     * @param hasher Hash function, e.g. a seeded \a hashing::WyHash
+     * @tparam Key Hashable Key data type
+     * @tparam Data Type of data to be stored by the table
+     * @tparam Hash Hash function
+     * @exception std::runtime_error Unable to allocate the table
+     */
+    explicit FlatHashMap(size_t capacity = DEFAULT_CAPACITY, Hash hasher = Hash());
+
+    /**@brief Copy constructor
+     * @param other table to be copied
+     */
+    FlatHashMap(const FlatHashMap &other);
+
+    /**@brief Move constructor
+     * @param other table to be moved, left empty
+     */
+    FlatHashMap(FlatHashMap &&other) noexcept;
+
+    /**@brief Assignment
+     * @param other table to be copied or moved
+     * @return reference to this table
+     */
+    FlatHashMap& operator=(FlatHashMap other) noexcept;
+
+    /**@brief Destructor
+     * @details Clears and deallocates the table
+     */
+    ~FlatHashMap();
+
+    /**@brief Get the number of elements from the table
+     * @details \f$O(1)\f$
+     * @return \b size_t number of elements in the table
+     */
+    size_t size() const noexcept {
+        return _size;
+    }
+
+    /**@brief Check if the table is empty
+     * @details \f$O(1)\f$
+     * @return \b Boolean \b true if the table is empty
+     */
+    bool empty() const noexcept {
+        return _size == 0;
+    }
+
+    /**@brief Number of slots of the table
+     * @details Always a power of two
+     * @return \b size_t number of slots
+     */
+    size_t bucket_count() const noexcept {
+        return capacity;
+    }
+
+    /**@brief Clear the table
+     * @details Removes all the elements but maintains the table capacity
+     */
+    void clear() noexcept;
+
+    /**@brief Reserve room for elements
+     * @details Grows the table so that \a count elements fit without growing again
+     * @param count number of elements
+     * @exception std::runtime_error Unable to allocate the table
+     */
+    void reserve(size_t count);
+
+    /**@brief Check if the table contains the \a key
+     * @details \f$O(1)\f$ expected
+     * @param key Key that needs to be checked
+     * @return \b Boolean \b true if the key is present in the table
+     */
+    bool contains_key(const lookup_key_t<Key> &key) const noexcept;
+
+    /**@brief Insert an entry in the table
+     * @details Nothing is changed when the key is already present. \f$O(1)\f$ amortised
+     * @param key Key for the entry
+     * @param data Data element of the entry
+     * @return \b Boolean \b true if the entry was inserted
+     * @exception std::runtime_error Unable to grow the table
+     */
+    bool insert(Key key, Data data);
+
+    /**@brief Insert an entry in the table
+     * @details \f$O(1)\f$ amortised
+     * @param element \a std::pair containing the key and data values.
+     * @return \b Boolean \b true if the entry was inserted
+     * @exception std::runtime_error Unable to grow the table
+     */
+    bool insert(std::pair<Key, Data> element);
+
+    /**@brief Get element using \a key
+     * @details Get the \a data value to the corresponding \a key value. If the key doesn't exist
+     * \a std::nullopt is returned. \f$O(1)\f$ expected
+     * @param key Key whose corresponding data value is to be found
+     * @return \b Data value wrapped in \a std::optional if the key is present else \b std::nullopt
+     */
+    std::optional<Data> get(const lookup_key_t<Key> &key) const;
+
+    /**@brief Remove an element from \a key
+     * @details Remove the element from the table if the key value exists in the table.
+     * \f$O(1)\f$ expected
+     *
+     * @param key Key whose corresponding element is to be removed
+     * @return \b Data value wrapped in \a std::optional if the key is removed else \b std::nullopt
+     */
+    std::optional<Data> remove(const lookup_key_t<Key> &key);
+
+    /**@brief Update an element value
+     * @details Update the element data value corresponding to the key value
+     * \f$O(1)\f$ expected
+     * @param key Key value whose corresponding data value is to be updated
+     * @param new_data Updated data value
+     * @return \b Boolean \b true if the value is updated successfully
+     */
+    bool update(const lookup_key_t<Key> &key, Data new_data);
+
+    /**@brief Find the data of \a key
+     * @details Looks the key up without copying the value. String keys are looked up through a
+     * \a std::string_view, so a view or a literal doesn't allocate a temporary key. The pointer
+     * stays valid until the next insert or remove. \f$O(1)\f$ expected
+     * @param key Key whose corresponding data value is to be found
+     * @return \b Data* pointer to the value in the table, \a nullptr if the key is absent
+     */
+    Data* find(const lookup_key_t<Key> &key) noexcept;
+
+    /**@brief Find the data of \a key
+     * @details \f$O(1)\f$ expected
+     * @param key Key whose corresponding data value is to be found
+     * @return \b const \b Data* pointer to the value in the table, \a nullptr if the key is absent
+     */
+    const Data* find(const lookup_key_t<Key> &key) const noexcept;
+
+    /**@brief Insert an entry if the key is absent
+     * @details The data is constructed in its slot from \a args, nothing is constructed when the key
+     * is already present. \f$O(1)\f$ expected
+     * @param key Key for the entry, copied into the table only when inserted
+     * @param args Arguments of the constructor of \a Data
+     * @return \b std::pair of the pointer to the value of the key and \b true if it was inserted
+     * @exception std::runtime_error Unable to grow the table
+     */
+    template<typename... Args>
+    std::pair<Data*, bool> try_emplace(const lookup_key_t<Key> &key, Args&&... args);
+
+    /**@brief Insert an entry built from \a args if its key is absent
+     * @details The entry is constructed as a \a std::pair<Key, Data> from \a args and moved into the
+     * table. \f$O(1)\f$ expected
+     * @param args Arguments of the constructor of \a std::pair<Key, Data>
+     * @return \b std::pair of the pointer to the value of the key and \b true if it was inserted
+     * @exception std::runtime_error Unable to grow the table
+     */
+    template<typename... Args>
+    std::pair<Data*, bool> emplace(Args&&... args);
+
+    /**@brief Access the data of \a key
+     * @details Inserts a default constructed \a Data when the key is absent. \f$O(1)\f$ expected
+     * @param key Key whose corresponding data value is to be accessed
+     * @return \b Data& reference to the value in the table
+     * @exception std::runtime_error Unable to grow the table
+     */
+    Data& operator[](const lookup_key_t<Key> &key);
+
+    /**
+     * @brief Key-Value pairs from the table
+     * @details In slot order. \f$O(capacity)\f$
+     * @return \b std::vector of the entries
+     */
+    std::vector<std::pair<Key, Data>> key_value() const;
+
+    /**
+     * @brief Keys from the table
+     * @details In slot order. \f$O(capacity)\f$
+     * @return \b std::vector of the keys
+     */
+    std::vector<Key> keys() const;
+
+    /**
+     * @brief Values from the table
+     * @details In slot order. \f$O(capacity)\f$
+     * @return \b std::vector of the values
+     */
+    std::vector<Data> values() const;
+};
+
+#endif //DATA_STRUCTURES_FLAT_HASH_MAP_HPP
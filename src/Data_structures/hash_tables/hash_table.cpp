@@ -1,8 +1,8 @@
 #include"hash_table.hpp"
 
 // Constructors and Destructors
-template<Hashable Key, typename Data>
-HashTable<Key, Data>::HashTable(size_t capacity, float load_factor) {
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+HashTable<Key, Data, Hash>::HashTable(size_t capacity, float load_factor, bool incremental, Hash hasher) : hasher(std::move(hasher)) {
     if(capacity < 0) throw std::invalid_argument("Capacity cannot be negative");
     if(load_factor <= 0 || 
             load_factor == std::numeric_limits<float>::infinity() || 
@@ -10,6 +10,7 @@ HashTable<Key, Data>::HashTable(size_t capacity, float load_factor) {
         throw std::invalid_argument("Invalid load factor for the table");
     try {
         this->load_factor = load_factor;
+        this->incremental = incremental;
         this->capacity = capacity;
         resize_threshold = (size_t) capacity * load_factor;
         table = new LinkedList<Element>[capacity];
@@ -20,55 +21,108 @@ HashTable<Key, Data>::HashTable(size_t capacity, float load_factor) {
     }
 }
 
-template<Hashable Key, typename Data>
-HashTable<Key, Data>::~HashTable(){
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+HashTable<Key, Data, Hash>::~HashTable(){
     clear();
     delete[] table;
 }
 
 // Private Functions
 
-template<Hashable Key, typename Data>
-size_t HashTable<Key, Data>::get_normalised_index(Key key) {
-    size_t hash_val = std::hash<Key>{}(key);
-    return hash_val % capacity;
+/*
+ * Moves the chains of the next REHASH_STEP buckets of the old table to the new one
+ */
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+void HashTable<Key, Data, Hash>::_rehash_step() {
+    if(old_table == nullptr) return;
+    size_t end = std::min(old_capacity, migrated + REHASH_STEP);
+    for(; migrated < end; migrated++) {
+        while(!old_table[migrated].empty()) {
+            auto elm = old_table[migrated].remove_first();
+            table[elm.hash_val % capacity].add_first(std::move(elm));
+        }
+    }
+    if(migrated == old_capacity) {
+        delete[] old_table;
+        old_table = nullptr;
+    }
 }
 
-template<Hashable Key, typename Data>
-void HashTable<Key, Data>::_resize_table() {
+/*
+ * Doubles the table once the threshold is reached. Stop the world moves every chain at once, the 
+ * incremental mode keeps the old table and moves a few buckets per insert or remove. A resize due 
+ * while the previous one is still running finishes it first
+ */
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+void HashTable<Key, Data, Hash>::_resize_table() {
     if(_size >= resize_threshold) {
-        auto old_capacity = capacity;
+        while(old_table != nullptr) _rehash_step();
+        auto current_capacity = capacity;
+        LinkedList<Element>* new_table;
         try {
-            this->capacity *= 2;
-            resize_threshold = load_factor * capacity;
-            LinkedList<Element>* new_table = new LinkedList<Element>[capacity];
-            for(int i = 0; i < old_capacity; i++) {
-                while(!table[i].empty()) {
-                    auto elm = table[i].remove_first();
-                    auto new_index = get_normalised_index(elm.key);
-                    new_table[new_index].add_first(elm);
-                }
-            }
-            std::swap(new_table, table);
-            delete[] new_table;
+            new_table = new LinkedList<Element>[std::max<size_t>(1, capacity * 2)];
         } catch(const std::bad_alloc& e) {
-            capacity = old_capacity;
-            resize_threshold = (size_t) load_factor * capacity;
             std::cerr << "Unable to resize the table";
-            std::runtime_error("Unable to resize the table");
+            throw std::runtime_error("Unable to resize the table");
+        }
+        capacity = std::max<size_t>(1, capacity * 2);
+        resize_threshold = load_factor * capacity;
+        old_table = table;
+        old_capacity = current_capacity;
+        migrated = 0;
+        table = new_table;
+        if(!incremental) {
+            while(old_table != nullptr) _rehash_step();
         }
     }
 
 }
 
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+size_t HashTable<Key, Data, Hash>::hash(const lookup_key_t<Key> &key) const {
+    return hasher(key);
+}
+
+/*
+ * While rehashing an entry is either in the new table or in the old one
+ */
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+typename HashTable<Key, Data, Hash>::Element* HashTable<Key, Data, Hash>::find_element(const lookup_key_t<Key> &key, size_t hash_val) noexcept {
+    auto matches = [&](const Element &element) { return element.matches(key, hash_val); };
+    Element* element = table[hash_val % capacity].find_if(matches);
+    if(element == nullptr && old_table != nullptr) element = old_table[hash_val % old_capacity].find_if(matches);
+    return element;
+}
+
+/*
+ * The new entry is the head of its chain
+ */
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+template<typename... Args>
+Data* HashTable<Key, Data, Hash>::emplace_new(size_t hash_val, Key key, Args&&... args) {
+    _resize_table();
+    _rehash_step();
+    auto &chain = table[hash_val % capacity];
+    chain.add_first(Element(std::in_place, hash_val, std::move(key), std::forward<Args>(args)...));
+    _size++;
+    return &chain.find_if([](const Element&) { return true; })->data;
+}
+
 // Table operations
 
-template<Hashable Key, typename Data>
-void HashTable<Key, Data>::clear() {
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+void HashTable<Key, Data, Hash>::clear() {
     try {
         for(int i = 0; i < capacity; i++) {
             table[i].clear();
         }
+        if(old_table != nullptr) {
+            for(size_t i = migrated; i < old_capacity; i++) {
+                old_table[i].clear();
+            }
+            delete[] old_table;
+            old_table = nullptr;
+        }
         _size = 0;
     } catch(const std::runtime_error& e) {
         std::cerr << "Unable to clear the table";
@@ -76,47 +130,77 @@ void HashTable<Key, Data>::clear() {
     }
 }
 
-template<Hashable Key, typename Data>
-bool HashTable<Key, Data>::contains_key(Key key) noexcept {
-    auto index = get_normalised_index(key);
-    return table[index].contains(Element(key));
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+bool HashTable<Key, Data, Hash>::contains_key(const lookup_key_t<Key> &key) noexcept {
+    return find_element(key, hash(key)) != nullptr;
 }
 
-template<Hashable Key, typename Data>
-void HashTable<Key, Data>::insert(Key key, Data data) {
-    _resize_table();
-    Element new_element = Element(key, data);
-    auto index = get_normalised_index(key);
-    table[index].add_first(new_element);
-    _size++;
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+void HashTable<Key, Data, Hash>::insert(Key key, Data data) {
+    size_t hash_val = hash(key);
+    emplace_new(hash_val, std::move(key), std::move(data));
 }
 
-template<Hashable Key, typename Data>
-void HashTable<Key, Data>::insert(std::pair<Key, Data> element) {
-    insert(element.first, element.second);
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+void HashTable<Key, Data, Hash>::insert(std::pair<Key, Data> element) {
+    insert(std::move(element.first), std::move(element.second));
 }
 
-template<Hashable Key, typename Data>
-std::optional<Data> HashTable<Key, Data>::get(Key key) {
-    auto index = get_normalised_index(key);
-    auto element_index = table[index].index(Element(key));
-    if(element_index == -1) return std::nullopt;
-    return std::optional<Data>{table[index][element_index].data};
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+std::optional<Data> HashTable<Key, Data, Hash>::get(const lookup_key_t<Key> &key) {
+    Element* element = find_element(key, hash(key));
+    if(element == nullptr) return std::nullopt;
+    return std::optional<Data>{element->data};
 }
 
-template<Hashable Key, typename Data>
-std::optional<Data> HashTable<Key, Data>::remove(Key key) {
-    auto index = get_normalised_index(key);
-    auto element_index = table[index].index(Element(key));
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+std::optional<Data> HashTable<Key, Data, Hash>::remove(const lookup_key_t<Key> &key) {
+    _rehash_step();
+    size_t hash_val = hash(key);
+    auto matches = [&](const Element &element) { return element.matches(key, hash_val); };
+    auto *chain = &table[hash_val % capacity];
+    auto element_index = chain->index_if(matches);
+    if(element_index == -1 && old_table != nullptr) {
+        chain = &old_table[hash_val % old_capacity];
+        element_index = chain->index_if(matches);
+    }
     if(element_index == -1) return std::nullopt;
     _size--;
-    return std::optional<Data>{table[index].remove_at(element_index).data};
+    return std::optional<Data>{chain->remove_at(element_index).data};
+}
+
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+bool HashTable<Key, Data, Hash>::update(const lookup_key_t<Key> &key, Data new_data) {
+    Element* element = find_element(key, hash(key));
+    if(element == nullptr) return false;
+    element->data = std::move(new_data);
+    return true;
+}
+
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+Data* HashTable<Key, Data, Hash>::find(const lookup_key_t<Key> &key) noexcept {
+    Element* element = find_element(key, hash(key));
+    return element == nullptr ? nullptr : &element->data;
+}
+
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+template<typename... Args>
+std::pair<Data*, bool> HashTable<Key, Data, Hash>::try_emplace(const lookup_key_t<Key> &key, Args&&... args) {
+    size_t hash_val = hash(key);
+    if(Element* element = find_element(key, hash_val)) return {&element->data, false};
+    return {emplace_new(hash_val, Key(key), std::forward<Args>(args)...), true};
+}
+
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+template<typename... Args>
+std::pair<Data*, bool> HashTable<Key, Data, Hash>::emplace(Args&&... args) {
+    std::pair<Key, Data> entry(std::forward<Args>(args)...);
+    size_t hash_val = hash(entry.first);
+    if(Element* element = find_element(entry.first, hash_val)) return {&element->data, false};
+    return {emplace_new(hash_val, std::move(entry.first), std::move(entry.second)), true};
 }
 
-template<Hashable Key, typename Data>
-bool HashTable<Key, Data>::update(Key key, Data new_data) {
-    auto index = get_normalised_index(key);
-    auto element_index = table[index].index(Element(key));
-    if(element_index == -1) return false;
-    return table[index].update_at(element_index, Element(key, new_data));
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+Data& HashTable<Key, Data, Hash>::operator[](const lookup_key_t<Key> &key) {
+    return *try_emplace(key).first;
 }
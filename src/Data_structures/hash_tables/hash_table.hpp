@@ -1,7 +1,7 @@
 /**
  * @file hash_table.hpp
  * @brief Generic Hash Table with chaining implementation
- * @details HashTable template class implementing generic Hash Table using \a std::hash for calculating the table index
+ * @details HashTable template class implementing generic Hash Table using the \a Hash function, \a hashing::WyHash by default, for calculating the table index
  * from the key,
  * @author atishek22 <kumaratishek22@gmail.com>
  * @date Jun 2021
@@ -18,24 +18,28 @@
 #include<concepts>
 #include<limits>
 #include<optional>
+#include<utility>
 #include<vector>
 
 #include"../linked_list/linked_list.hpp"
 #include "../../Utils/hashable.hpp"
+#include "../../Utils/hash.hpp"
 
 /**@brief HashTable Template Class 
  * @details Hash table implementation using separate chaining as the method for hashing conflict resolution
  *
  * @tparam Key Hashable Key data type
  * @tparam Data Type of data to be stored by the table
+ * @tparam Hash Hash function of the keys and their lookup type, see \a hashing::WyHash
  *
  * @warning Not thread safe
  */
-template<Hashable Key, typename Data>
+template<typename Key, typename Data, KeyHasher<Key> Hash = hashing::WyHash>
 class HashTable {
 private:
     static constexpr int DEFAULT_CAPACITY = 3;
     static constexpr float DEFAULT_LOAD_FACTOR = 1.2;
+    static constexpr size_t REHASH_STEP = 4;
 
     class Element {
     public:
@@ -43,26 +47,40 @@ private:
         Key key;
         Data data;
 
-        Element(Key key, Data data = Data()) { 
-            this->key = key;
-            this->data = data;
-            this->hash_val = std::hash<Key>{}(key);
-        }
+        template<typename... Args>
+        Element(std::in_place_t, size_t hash_val, Key key, Args&&... args) :
+            hash_val(hash_val), key(std::move(key)), data(std::forward<Args>(args)...) {}
 
         bool operator==(const Element& other) {
             if(this->hash_val != other.hash_val) return false;
             return this->key == other.key;
         }
+
+        bool matches(const lookup_key_t<Key>& key, size_t hash_val) const {
+            return this->hash_val == hash_val && this->key == key;
+        }
     };
 
     LinkedList<Element>* table;
+    // table being emptied into table by an incremental resize, buckets [0, migrated) are done
+    LinkedList<Element>* old_table = nullptr;
+    Hash hasher;
     float load_factor;
+    bool incremental;
     size_t capacity, _size, resize_threshold;
-
-    size_t get_normalised_index(Key key);
+    size_t old_capacity = 0, migrated = 0;
 
     void _resize_table();
 
+    void _rehash_step();
+
+    size_t hash(const lookup_key_t<Key> &key) const;
+
+    Element* find_element(const lookup_key_t<Key> &key, size_t hash_val) noexcept;
+
+    template<typename... Args>
+    Data* emplace_new(size_t hash_val, Key key, Args&&... args);
+
 
 public:
     /**@brief Default constructor
@@ -70,12 +88,17 @@ public:
      * default if not specified.
      * @param capacity Max capacity of the table - index range - \f$[0, capacity)\f$
      * @param load_factor \f$(\alpha)\f$  ratio the number of elements to the capacity - define the resize threshold for the table
+     * @param incremental Resize incrementally: the chains of the old table move to the new one a few buckets per
+     * insert or remove while lookups search both, so no single insert rehashes the whole table
      * @tparam Key Hashable Key data type
+     * @param hasher Hash function, e.g. a seeded \a hashing::WyHash
      * @tparam Data Type of data to be stored by the table
+     * @tparam Hash Hash function
      * @exception std::illegal_argument Invalid \a capacity or \a loadFactor
      * @exception std::runtime_error Unable to allocate the table
      */
-    HashTable(size_t capacity = DEFAULT_CAPACITY, float load_factor = DEFAULT_LOAD_FACTOR);
+    HashTable(size_t capacity = DEFAULT_CAPACITY, float load_factor = DEFAULT_LOAD_FACTOR, bool incremental = false,
+              Hash hasher = Hash());
 
     /**@brief Default Destructor
      * @details Clears and deallocates the table.
@@ -98,6 +121,14 @@ public:
         return _size == 0;
     }
 
+    /**@brief Check if an incremental resize is running
+     * @details \f$O(1)\f$
+     * @return \b Boolean \b true if entries are left in the old table
+     */
+    bool rehashing() const noexcept {
+        return old_table != nullptr;
+    }
+
     /**@brief Clear the table
      * @details Removes all the elements and maintains the table capacity. \f$O(\alpha n)\f$
      * @exception std::runtime_error Unable to clear the table.
@@ -109,7 +140,7 @@ public:
      * @param key Key that needs to be checked
      * @return \b Boolean \b true if the key is present in the table
      */
-    bool contains_key(Key key) noexcept;
+    bool contains_key(const lookup_key_t<Key> &key) noexcept;
 
     /**@brief Insert an entry in the table
      * @details \f$O(1)\f$
@@ -134,7 +165,7 @@ public:
      * @param key Key whose corresponding data value is to be found
      * @return \b Data value wrapped in \a std::optional if the key is present else \b std::nullopt
      */
-    std::optional<Data> get(Key key);
+    std::optional<Data> get(const lookup_key_t<Key> &key);
 
     /**@brief Remove an element from \a key
      * @details Remove the element from the table if the key value exists in the table.
@@ -144,7 +175,7 @@ public:
      * @exception std::runtime_error
      * @return \b Data value wrapped in \a std::optional if the key is removed else \b std::nullopt
      */
-    std::optional<Data> remove(Key key);
+    std::optional<Data> remove(const lookup_key_t<Key> &key);
 
     /**@brief Update an element value
      * @details Update the element data value corresponding to the key value
@@ -153,7 +184,45 @@ public:
      * @param newData Updated data value
      * @return \b Boolean \b true if the value is updated successfully
      */
-    bool update(Key key, Data new_data);
+    bool update(const lookup_key_t<Key> &key, Data new_data);
+
+    /**@brief Find the data of \a key
+     * @details Looks the key up without copying the value. String keys are looked up through a
+     * \a std::string_view, so a view or a literal doesn't allocate a temporary key. The pointer
+     * stays valid until the entry is removed. \f$O(\alpha)\f$
+     * @param key Key whose corresponding data value is to be found
+     * @return \b Data* pointer to the value in the table, \a nullptr if the key is absent
+     */
+    Data* find(const lookup_key_t<Key> &key) noexcept;
+
+    /**@brief Insert an entry if the key is absent
+     * @details The data is constructed from \a args, nothing is constructed when the key is already
+     * present. \f$O(\alpha)\f$
+     * @param key Key for the entry, copied into the table only when inserted
+     * @param args Arguments of the constructor of \a Data
+     * @return \b std::pair of the pointer to the value of the key and \b true if it was inserted
+     * @exception std::runtime_error Unable to resize the table
+     */
+    template<typename... Args>
+    std::pair<Data*, bool> try_emplace(const lookup_key_t<Key> &key, Args&&... args);
+
+    /**@brief Insert an entry built from \a args if its key is absent
+     * @details The entry is constructed as a \a std::pair<Key, Data> from \a args and moved into the
+     * table. \f$O(\alpha)\f$
+     * @param args Arguments of the constructor of \a std::pair<Key, Data>
+     * @return \b std::pair of the pointer to the value of the key and \b true if it was inserted
+     * @exception std::runtime_error Unable to resize the table
+     */
+    template<typename... Args>
+    std::pair<Data*, bool> emplace(Args&&... args);
+
+    /**@brief Access the data of \a key
+     * @details Inserts a default constructed \a Data when the key is absent. \f$O(\alpha)\f$
+     * @param key Key whose corresponding data value is to be accessed
+     * @return \b Data& reference to the value in the table
+     * @exception std::runtime_error Unable to resize the table
+     */
+    Data& operator[](const lookup_key_t<Key> &key);
 
 
     /** @brief Iterator for the hash table
@@ -2,55 +2,155 @@
 
 // Private Functions
 //
-template<Hashable Key, typename Data>
-size_t HashTableOA<Key, Data>::get_normalised_index(Key key) {
-    size_t hash_val = std::hash<Key>{}(key);
-    return hash_val % capacity;
+template<typename Key, typename Data, ProbingPolicy Probe, KeyHasher<Key> Hash>
+size_t HashTableOA<Key, Data, Probe, Hash>::get_normalised_index(size_t hash_val, size_t capacity) {
+    return hash_val & (capacity - 1);
 }
 
-template<Hashable Key, typename Data>
-size_t HashTableOA<Key, Data>::normalise(size_t index) {
-    return index % capacity;
+template<typename Key, typename Data, ProbingPolicy Probe, KeyHasher<Key> Hash>
+size_t HashTableOA<Key, Data, Probe, Hash>::probe(size_t home, size_t x, size_t hash_val, size_t capacity) {
+    return (home + Probe::offset(x, hash_val)) & (capacity - 1);
 }
 
-template<Hashable Key, typename Data>
-void HashTableOA<Key, Data>::_resize_table() {
-    if(_size >= resize_threshold) {
-        auto old_capacity = capacity;
-        try {
-            get_adjusted_capacity();
-            this->resize_threshold = load_factor * capacity;
-            Element* new_table = new Element[capacity];
-            std::swap(new_table, table);
-            _size = 0;
-            for(int i = 0; i < old_capacity; i++) {
-                if(!new_table[i].empty() && !new_table[i].deleted()) {
-                    insert(new_table[i].key, new_table[i].data);
+template<typename Key, typename Data, ProbingPolicy Probe, KeyHasher<Key> Hash>
+size_t HashTableOA<Key, Data, Probe, Hash>::hash(const lookup_key_t<Key> &key) const {
+    return hasher(key);
+}
+
+/*
+ * Index of the key in t, capacity when it isn't there. With compact the entry found moves to the
+ * first deleted place of its probe sequence
+ */
+template<typename Key, typename Data, ProbingPolicy Probe, KeyHasher<Key> Hash>
+size_t HashTableOA<Key, Data, Probe, Hash>::find_slot(Element* t, size_t capacity, const lookup_key_t<Key> &key, size_t hash_val, bool compact) {
+    auto index = get_normalised_index(hash_val, capacity);
+    for(size_t i = index, found = -1, x = 1; ;i = probe(index, x++, hash_val, capacity)){
+        // The position has been deleted but there may be more elements ahead
+        if(t[i].deleted()) {
+            if(found == -1 && compact) {
+                found = i;
+            }
+        } else if(!t[i].empty()) {
+            if(t[i].matches(key, hash_val)) {
+                // There is a deleted place 
+                if(found != -1) {
+                    t[found] = std::move(t[i]);
+                    t[i] = DELETED;
+                    return found;
                 }
+                return i;
             }
-            delete[] new_table;    
+        } else return capacity;
+    }
+}
+
+/*
+ * While rehashing an entry is either in the new table or in the old one
+ */
+template<typename Key, typename Data, ProbingPolicy Probe, KeyHasher<Key> Hash>
+typename HashTableOA<Key, Data, Probe, Hash>::Element* HashTableOA<Key, Data, Probe, Hash>::find_element(const lookup_key_t<Key> &key, size_t hash_val) {
+    size_t i = find_slot(table, capacity, key, hash_val, true);
+    if(i != capacity) return table + i;
+    if(old_table == nullptr) return nullptr;
+    i = find_slot(old_table, old_capacity, key, hash_val, false);
+    return i != old_capacity ? old_table + i : nullptr;
+}
+
+/*
+ * Puts the element in the first free slot of its probe sequence in table
+ */
+template<typename Key, typename Data, ProbingPolicy Probe, KeyHasher<Key> Hash>
+size_t HashTableOA<Key, Data, Probe, Hash>::place(Element &&element) {
+    auto index = get_normalised_index(element.hash_val, capacity);
+    for(size_t i = index, x = 1; ;i = probe(index, x++, element.hash_val, capacity)){
+        if(table[i].deleted() || table[i].empty()) {
+            if(table[i].deleted()) tombstones--;
+            table[i] = std::move(element);
+            return i;
+        } 
+    }
+}
+
+template<typename Key, typename Data, ProbingPolicy Probe, KeyHasher<Key> Hash>
+template<typename... Args>
+Data* HashTableOA<Key, Data, Probe, Hash>::emplace_new(size_t hash_val, Key key, Args&&... args) {
+    _resize_table();
+    _rehash_step();
+    size_t i = place(Element(std::in_place, hash_val, std::move(key), std::forward<Args>(args)...));
+    _size++;
+    return &table[i].data;
+}
+
+/*
+ * Moves the entries of the next REHASH_STEP slots of the old table to the new one. The moved slots
+ * become deleted so that the probe sequences of the old table stay intact
+ */
+template<typename Key, typename Data, ProbingPolicy Probe, KeyHasher<Key> Hash>
+void HashTableOA<Key, Data, Probe, Hash>::_rehash_step() {
+    if(old_table == nullptr) return;
+    size_t end = std::min(old_capacity, migrated + REHASH_STEP);
+    for(; migrated < end; migrated++) {
+        if(!old_table[migrated].empty() && !old_table[migrated].deleted()) {
+            place(std::move(old_table[migrated]));
+            old_table[migrated] = DELETED;
+        }
+    }
+    if(migrated == old_capacity) {
+        delete[] old_table;
+        old_table = nullptr;
+    }
+}
+
+/*
+ * Rebuilds the table once the entries and the tombstones reach the threshold, so that every probe
+ * sequence keeps meeting an empty slot. Stop the world moves every entry at once, the incremental
+ * mode keeps the old table and moves a few slots per insert or remove. A resize due while the
+ * previous one is still running finishes it first
+ */
+template<typename Key, typename Data, ProbingPolicy Probe, KeyHasher<Key> Hash>
+void HashTableOA<Key, Data, Probe, Hash>::_resize_table() {
+    if(_size + tombstones >= resize_threshold) {
+        while(old_table != nullptr) _rehash_step();
+        auto current_capacity = capacity;
+        Element* new_table;
+        try {
+            get_adjusted_capacity();
+            new_table = new Element[capacity];
         } 
         catch(const std::bad_alloc& e) {
-            capacity = old_capacity;
-            resize_threshold = (size_t) load_factor * capacity;
+            capacity = current_capacity;
             std::cerr << "Unable to resize the table";
-            std::runtime_error("Unable to resize the table");
+            throw std::runtime_error("Unable to resize the table");
+        }
+        this->resize_threshold = load_factor * capacity;
+        tombstones = 0;
+        old_table = table;
+        old_capacity = current_capacity;
+        migrated = 0;
+        table = new_table;
+        if(!incremental) {
+            while(old_table != nullptr) _rehash_step();
         }
     } 
 }
 
-template<Hashable Key, typename Data>
-void HashTableOA<Key, Data>::get_adjusted_capacity() {
-    capacity *= 2;
+/*
+ * Same capacity when at most half the threshold is live entries, the rest being tombstones, else
+ * twice the capacity
+ */
+template<typename Key, typename Data, ProbingPolicy Probe, KeyHasher<Key> Hash>
+void HashTableOA<Key, Data, Probe, Hash>::get_adjusted_capacity() {
+    if(tombstones == 0 || _size > resize_threshold / 2) capacity *= 2;
 }
 
 // Constructors and Destructors
-template<Hashable Key, typename Data>
-HashTableOA<Key, Data>::HashTableOA(
-        std::function<size_t(size_t)> probe_function,
+template<typename Key, typename Data, ProbingPolicy Probe, KeyHasher<Key> Hash>
+HashTableOA<Key, Data, Probe, Hash>::HashTableOA(
         size_t capacity,
-        float load_factor
-        ) {
+        float load_factor,
+        bool incremental,
+        Hash hasher
+        ) : hasher(std::move(hasher)) {
     if(capacity < 0) throw std::invalid_argument("Capacity cannot be negative");
     if(load_factor <= 0 ||
             load_factor == std::numeric_limits<float>::infinity() ||
@@ -58,10 +158,11 @@ HashTableOA<Key, Data>::HashTableOA(
         throw std::invalid_argument("Invalid load factor for the table");
     try {
         this->load_factor = load_factor;
-        this->capacity = capacity;
-        this->probe = probe_function;
-        resize_threshold = (size_t)capacity * load_factor;
-        table = new Element[capacity];
+        this->incremental = incremental;
+        this->capacity = 1;
+        while(this->capacity < capacity) this->capacity *= 2;
+        resize_threshold = (size_t)(this->capacity * load_factor);
+        table = new Element[this->capacity];
         _size = 0;
     } catch(const std::bad_alloc& e) {
         std::cerr << "Unable to allocate the table";
@@ -69,126 +170,114 @@ HashTableOA<Key, Data>::HashTableOA(
     }
 }
 
-template<Hashable Key, typename Data>
-HashTableOA<Key, Data>::~HashTableOA() {
+template<typename Key, typename Data, ProbingPolicy Probe, KeyHasher<Key> Hash>
+HashTableOA<Key, Data, Probe, Hash>::~HashTableOA() {
     delete[] table;
+    delete[] old_table;
 }
 // Operations
 
-template<Hashable Key, typename Data>
-void HashTableOA<Key, Data>::clear() {
+template<typename Key, typename Data, ProbingPolicy Probe, KeyHasher<Key> Hash>
+void HashTableOA<Key, Data, Probe, Hash>::clear() {
     try{
         delete[] table;
+        delete[] old_table;
+        old_table = nullptr;
         table = new Element[capacity];
-        _size = 0;
+        _size = tombstones = 0;
     }catch(const std::bad_alloc& e) {
         std::cerr << "Unable to clear the table";
         throw std::runtime_error(e.what());
     }
 }
 
-template<Hashable Key, typename Data>
-bool HashTableOA<Key, Data>::contains_key(Key key) noexcept {
-    auto index = get_normalised_index(key);
-    for(size_t i = index, found = -1, x = 1; ;i = normalise(i + probe(x++))){
-        // The position has been deleted but there may be more elements ahead
-        if(table[i].deleted()) {
-            if(found == -1) {
-                found = i;
-            }
-        } else if(!table[i].empty()) {
-            if(table[i] == Element(key)) {
-                // There is a deleted place 
-                if(found != -1) {
-                    table[found] = table[i];
-                    table[i] = DELETED;
-                }
-                return true;
-            }
-        } else return false;
-    }
+template<typename Key, typename Data, ProbingPolicy Probe, KeyHasher<Key> Hash>
+bool HashTableOA<Key, Data, Probe, Hash>::contains_key(const lookup_key_t<Key> &key) noexcept {
+    return find_element(key, hash(key)) != nullptr;
 }
 
-template<Hashable Key, typename Data>
-void HashTableOA<Key, Data>::insert(Key key, Data data) {
-    _resize_table();
-    Element new_element = Element(key, data);
-    auto index = get_normalised_index(key);
-    size_t found = -1;
-    for(size_t i = index, x = 1; ;i = normalise(i + probe(x++))){
-        if(table[i].deleted() || table[i].empty()) {
-            found = i;
-            break;
-        } 
-    }
-    table[found] = new_element;
-    _size++;
+template<typename Key, typename Data, ProbingPolicy Probe, KeyHasher<Key> Hash>
+void HashTableOA<Key, Data, Probe, Hash>::insert(Key key, Data data) {
+    size_t hash_val = hash(key);
+    emplace_new(hash_val, std::move(key), std::move(data));
 }
 
-template<Hashable Key, typename Data>
-void HashTableOA<Key, Data>::insert(std::pair<Key, Data> element) {
-    insert(element.first, element.second);
+template<typename Key, typename Data, ProbingPolicy Probe, KeyHasher<Key> Hash>
+void HashTableOA<Key, Data, Probe, Hash>::insert(std::pair<Key, Data> element) {
+    insert(std::move(element.first), std::move(element.second));
 }
 
-template<Hashable Key, typename Data>
-std::optional<Data> HashTableOA<Key, Data>::get(Key key) {
-    auto index = get_normalised_index(key);
-    for(size_t i = index, x = 1, found = -1; ;i = normalise(i + probe(x++))) {
-        if(table[i].deleted()) {
-            if(found == -1) {
-                found = i;
-            }
-        }
-        else if(table[i] == Element(key)) {
-            Element ret = table[i];
-            if(found != -1) {
-                table[found] = table[i];
-                table[i] = DELETED;
-            }
-            return std::optional<Data>{ret.data};
-        } else if(table[i].empty()) {
-            return std::nullopt;
-        }
-    }
-    return std::nullopt;
-}
-
-template<Hashable Key, typename Data>
-std::optional<Data> HashTableOA<Key, Data>::remove(Key key) {
-    auto index = get_normalised_index(key);
-    for(size_t i = index, x = 1, found = -1; ;i= normalise(i + probe(x++))) {
-        if(table[i].deleted()) {
-            continue;
-        } else if(table[i].empty()) {
-            return std::nullopt;
-        } else if(table[i] == Element(key)) {
-            auto ret = table[i];
-            table[i] = DELETED;
-            _size--;
-            return std::optional<Data>{ret.data};
-        }
+template<typename Key, typename Data, ProbingPolicy Probe, KeyHasher<Key> Hash>
+std::optional<Data> HashTableOA<Key, Data, Probe, Hash>::get(const lookup_key_t<Key> &key) {
+    Element* element = find_element(key, hash(key));
+    if(element == nullptr) return std::nullopt;
+    return std::optional<Data>{element->data};
+}
+
+template<typename Key, typename Data, ProbingPolicy Probe, KeyHasher<Key> Hash>
+std::optional<Data> HashTableOA<Key, Data, Probe, Hash>::remove(const lookup_key_t<Key> &key) {
+    _rehash_step();
+    size_t hash_val = hash(key);
+    Element* t = table;
+    size_t i = find_slot(table, capacity, key, hash_val, false);
+    if(i == capacity) {
+        if(old_table == nullptr) return std::nullopt;
+        t = old_table;
+        i = find_slot(old_table, old_capacity, key, hash_val, false);
+        if(i == old_capacity) return std::nullopt;
     }
+    std::optional<Data> ret{std::move(t[i].data)};
+    t[i] = DELETED;
+    if(t == table) tombstones++;
+    _size--;
+    return ret;
 }
 
-template<Hashable Key, typename Data>
-bool HashTableOA<Key, Data>::update(Key key, Data new_data) {
-    auto index = get_normalised_index(key);
-    for(size_t i = index, found = -1, x = 1; ;i = normalise(i + probe(x++))){
-        // The position has been deleted but there may be more elements ahead
-        if(table[i].deleted()) {
-            if(found == -1) {
-                found = i;
-            }
-        } else if(!table[i].empty()) {
-            if(table[i] == Element(key)) {
-                table[i].data = new_data;
-                // There is a deleted place 
-                if(found != -1) {
-                    table[found] = table[i];
-                    table[i] = DELETED;
-                }
-                return true;
-            }
-        } else return false;
+template<typename Key, typename Data, ProbingPolicy Probe, KeyHasher<Key> Hash>
+bool HashTableOA<Key, Data, Probe, Hash>::update(const lookup_key_t<Key> &key, Data new_data) {
+    Element* element = find_element(key, hash(key));
+    if(element == nullptr) return false;
+    element->data = std::move(new_data);
+    return true;
+}
+
+template<typename Key, typename Data, ProbingPolicy Probe, KeyHasher<Key> Hash>
+Data* HashTableOA<Key, Data, Probe, Hash>::find(const lookup_key_t<Key> &key) noexcept {
+    Element* element = find_element(key, hash(key));
+    return element == nullptr ? nullptr : &element->data;
+}
+
+template<typename Key, typename Data, ProbingPolicy Probe, KeyHasher<Key> Hash>
+template<typename... Args>
+std::pair<Data*, bool> HashTableOA<Key, Data, Probe, Hash>::try_emplace(const lookup_key_t<Key> &key, Args&&... args) {
+    size_t hash_val = hash(key);
+    if(Element* element = find_element(key, hash_val)) return {&element->data, false};
+    return {emplace_new(hash_val, Key(key), std::forward<Args>(args)...), true};
+}
+
+template<typename Key, typename Data, ProbingPolicy Probe, KeyHasher<Key> Hash>
+template<typename... Args>
+std::pair<Data*, bool> HashTableOA<Key, Data, Probe, Hash>::emplace(Args&&... args) {
+    std::pair<Key, Data> entry(std::forward<Args>(args)...);
+    size_t hash_val = hash(entry.first);
+    if(Element* element = find_element(entry.first, hash_val)) return {&element->data, false};
+    return {emplace_new(hash_val, std::move(entry.first), std::move(entry.second)), true};
+}
+
+template<typename Key, typename Data, ProbingPolicy Probe, KeyHasher<Key> Hash>
+Data& HashTableOA<Key, Data, Probe, Hash>::operator[](const lookup_key_t<Key> &key) {
+    return *try_emplace(key).first;
+}
+
+template<typename Key, typename Data, ProbingPolicy Probe, KeyHasher<Key> Hash>
+std::vector<size_t> HashTableOA<Key, Data, Probe, Hash>::probe_histogram() const {
+    std::vector<size_t> histogram;
+    for(size_t slot = 0; slot < capacity; slot++) {
+        if(table[slot].empty() || table[slot].deleted()) continue;
+        size_t hash_val = table[slot].hash_val, index = get_normalised_index(hash_val, capacity), x = 0;
+        for(size_t i = index; i != slot; i = probe(index, ++x, hash_val, capacity));
+        if(x >= histogram.size()) histogram.resize(x + 1, 0);
+        histogram[x]++;
     }
+    return histogram;
 }
@@ -1,6 +1,6 @@
 /**@file hash_table_open_addressing.hpp
- * @brief Generic Hash Table with Open Addressing and callback probing functions
- * @details HashTableOA template class implementing a generic Hash Table with open addressing using \a std::hash  for calculating the table index
+ * @brief Generic Hash Table with Open Addressing and compile time probing policies
+ * @details HashTableOA template class implementing a generic Hash Table with open addressing using the \a Hash function, \a hashing::WyHash by default, for calculating the table index
  * @author atishek22 <kumaratishek22@gmail.com>
  * @date Jul 2021
  * @warning Not thread safe
@@ -12,54 +12,84 @@
 #include<stdexcept>
 #include<functional>
 #include<iostream>
+#include<limits>
 #include<optional>
+#include<utility>
 #include<vector>
 
 #include"../../Utils/hashable.hpp"
+#include"../../Utils/hash.hpp"
 
-/**@brief Probing functions
- * @details Pre-defined probing functions for the HashTableOA
+/**@brief Probing policies
+ * @details Pre-defined probing policies for the HashTableOA. A policy gives the offset from the home
+ * slot of the \a x th probe, \f$x \geq 1\f$, for a key of hash \a hash. The table size is a power of two
+ * and every policy visits all the slots.
  */
 namespace probing {
 
-    const int PROBE_CONSTANT = 17;
+    /**@brief Linear probing policy for HashTableOA
+     * @details \f$ offset = x \f$, consecutive slots share cache lines
+     */
+    struct Linear {
+        static constexpr size_t offset(size_t x, size_t) noexcept {
+            return x;
+        }
+    };
 
-    /**@brief Linear probing function for HashTableOA
-     * @details \f$ offset * prime \f$
-     * @return \b size_t offset from the hash value
+    /** @brief Quadratic probing policy for HashTableOA
+     * @details \f$ offset = ({x}^2 + x)/2 \f$, triangular numbers visit every slot of a power of two
+     * table and break up the clusters of linear probing
      */
-    std::function<size_t(size_t)> linear = [](size_t offset) {
-        return offset * PROBE_CONSTANT;
+    struct Quadratic {
+        static constexpr size_t offset(size_t x, size_t) noexcept {
+            return (x * x + x) / 2;
+        }
     };
 
-    /** @brief Quadratic probing function for HashTableOA
-     * @details \f$ ({offset}^2 + offset)/2 \f$
-     * @return \b size_t offset from the hash value
+    /** @brief Double hashing policy for HashTableOA
+     * @details \f$ offset = x \cdot step \f$ with an odd \a step taken from the high bits of the hash,
+     * keys colliding on the home slot follow different sequences
      */
-    std::function<size_t(size_t)> quadratic = [](size_t index) {
-        return (index * index + index) / 2;
+    struct DoubleHashing {
+        static constexpr size_t offset(size_t x, size_t hash) noexcept {
+            return x * ((hash >> (4 * sizeof(size_t))) | 1);
+        }
     };
 }
 
+/**@brief Probing policy concept
+ * @details Constraint for the probing policy of the HashTableOA, see the \a probing namespace
+ */
+template<typename Probe>
+concept ProbingPolicy = requires(size_t x, size_t hash) {
+    {Probe::offset(x, hash)} -> std::convertible_to<size_t>;
+};
+
 /**@brief HashTable Template Class with Open Addressing 
  * @details Hash table implementation using Open Addressing and probing as the method for hashing conflict resolution
  *
+ * The table size is a power of two so that the slot of a hash is a mask, the probing policy is a
+ * template parameter so that the probe loop is inlined.
+ *
  * @tparam Key Hashable Key data type
  * @tparam Data Type of data to be stored by the table
+ * @tparam Probe Probing policy, one of the \a probing policies
+ * @tparam Hash Hash function of the keys and their lookup type, \a hashing::WyHash mixes every bit.
+ * With \a std::hash, the identity on the integers, strided keys share their low bits and pile up
  *
  * @warning Not thread safe
  *
- * @todo adjust_capacity callback for better probing
  * @todo Check for duplicate keys and modify the value if key exists (Probably give an optional parameter to allow for duplicates)
  *
  * @bug Doesn't work for duplicate keys, If needed should use HashTable.
  */
-template<Hashable Key, typename Data>
+template<typename Key, typename Data, ProbingPolicy Probe = probing::Linear, KeyHasher<Key> Hash = hashing::WyHash>
 class HashTableOA {
 
 private:
-    static constexpr int DEFAULT_CAPACITY = 3;
+    static constexpr int DEFAULT_CAPACITY = 4;
     static constexpr float DEFAULT_LOAD_FACTOR = 0.8;
+    static constexpr size_t REHASH_STEP = 16;
 
     class Element {
     public:
@@ -68,12 +98,11 @@ private:
         Data data;
         int flag;
 
-        Element(Key key, Data data = Data(), int flag = 0) { 
-            this->key = key;
-            this->data = data;
-            this->hash_val = std::hash<Key>{}(key);
-            this->flag = flag;
-        }
+        explicit Element(int flag) : hash_val(0), key(), data(), flag(flag) {}
+
+        template<typename... Args>
+        Element(std::in_place_t, size_t hash_val, Key key, Args&&... args) :
+            hash_val(hash_val), key(std::move(key)), data(std::forward<Args>(args)...), flag(0) {}
 
         Element() {
             key = Key();
@@ -87,6 +116,10 @@ private:
             return this->key == other.key;
         }
 
+        bool matches(const lookup_key_t<Key>& key, size_t hash_val) {
+            return this->hash_val == hash_val && this->key == key;
+        }
+
         bool empty() {
             return flag == 1;
         }
@@ -97,14 +130,33 @@ private:
     };
 
     Element* table;
-    const Element DELETED = Element(Key(), Data(), -1);
+    // table being emptied into table by an incremental resize, slots [0, migrated) are done
+    Element* old_table = nullptr;
+    const Element DELETED = Element(-1);
+    Hash hasher;
     float load_factor;
+    bool incremental;
     size_t capacity, _size, resize_threshold;
-    std::function<size_t(size_t)> probe;
+    // deleted slots of table, they end probes as little as the entries do
+    size_t tombstones = 0;
+    size_t old_capacity = 0, migrated = 0;
+
+    static size_t get_normalised_index(size_t hash_val, size_t capacity);
+
+    static size_t probe(size_t home, size_t x, size_t hash_val, size_t capacity);
+
+    size_t hash(const lookup_key_t<Key> &key) const;
 
-    size_t get_normalised_index(Key key);
+    size_t find_slot(Element* t, size_t capacity, const lookup_key_t<Key> &key, size_t hash_val, bool compact);
 
-    size_t normalise(size_t index);
+    Element* find_element(const lookup_key_t<Key> &key, size_t hash_val);
+
+    size_t place(Element &&element);
+
+    template<typename... Args>
+    Data* emplace_new(size_t hash_val, Key key, Args&&... args);
+
+    void _rehash_step();
 
     void get_adjusted_capacity();
 
@@ -112,20 +164,25 @@ private:
 
 public:
     /**@brief Default constructor
-     * @details Creates an empty hash table with the specified \a probe_function, \a load_factor and \a capacity. Fall backs to the
+     * @details Creates an empty hash table with the specified \a load_factor and \a capacity. Fall backs to the
      * default if not specified.
-     * @param probe_function Callback probe function for same index hash conflict resolution.
-     * @param capacity Max capacity of the table - index range - \f$[0, capacity)\f$
+     * @param capacity Max capacity of the table - index range - \f$[0, capacity)\f$, rounded up to a power of two
      * @param load_factor \f$(\alpha)\f$  ratio the number of elements to the capacity - define the resize threshold for the table
+     * @param incremental Resize incrementally: the entries of the old table move to the new one a few slots per
+     * insert or remove while lookups search both, so no single insert rehashes the whole table
      * @tparam Key Hashable Key data type
      * @tparam Data Type of data to be stored by the table
+     * @param hasher Hash function, e.g. a seeded \a hashing::WyHash
+     * @tparam Probe Probing policy
+     * @tparam Hash Hash function
      * @exception std::illegal_argument Invalid \a capacity or \a loadFactor
      * @exception std::runtime_error Unable to allocate the table
      */
     HashTableOA(
-            std::function<size_t(size_t)> probe_function = probing::linear, 
             size_t capacity = DEFAULT_CAPACITY, 
-            float load_factor = DEFAULT_LOAD_FACTOR);
+            float load_factor = DEFAULT_LOAD_FACTOR,
+            bool incremental = false,
+            Hash hasher = Hash());
 
     /**@brief Destructor
      * @details Clears and deallocates the table
@@ -148,6 +205,14 @@ public:
         return _size == 0;
     }
 
+    /**@brief Check if an incremental resize is running
+     * @details \f$O(1)\f$
+     * @return \b Boolean \b true if entries are left in the old table
+     */
+    bool rehashing() const noexcept {
+        return old_table != nullptr;
+    }
+
     /**@brief Clear the table
      * @details Removes all the elements but maintains the table capacity
      * @exception std::runtime_error Unable to clear the table
@@ -159,7 +224,7 @@ public:
      * @param key Key that needs to be checked
      * @return \b Boolean \b true if the key is present in the table
      */
-    bool contains_key(Key key) noexcept;
+    bool contains_key(const lookup_key_t<Key> &key) noexcept;
     
     /**@brief Insert an entry in the table
      * @details \f$O(1)\f$
@@ -183,7 +248,7 @@ public:
      * @param key Key whose corresponding data value is to be found
      * @return \b Data value wrapped in \a std::optional if the key is present else \b std::nullopt
      */
-    std::optional<Data> get(Key key);
+    std::optional<Data> get(const lookup_key_t<Key> &key);
 
     /**@brief Remove an element from \a key
      * @details Remove the element from the table if the key value exists in the table.
@@ -193,7 +258,7 @@ public:
      * @exception std::runtime_error
      * @return \b Data value wrapped in \a std::optional if the key is removed else \b std::nullopt
      */
-    std::optional<Data> remove(Key key);
+    std::optional<Data> remove(const lookup_key_t<Key> &key);
 
     /**@brief Update an element value
      * @details Update the element data value corresponding to the key value
@@ -202,7 +267,54 @@ public:
      * @param newData Updated data value
      * @return \b Boolean \b true if the value is updated successfully
      */
-    bool update(Key key, Data new_data);
+    bool update(const lookup_key_t<Key> &key, Data new_data);
+
+    /**@brief Find the data of \a key
+     * @details Looks the key up without copying the value. String keys are looked up through a
+     * \a std::string_view, so a view or a literal doesn't allocate a temporary key. The pointer
+     * stays valid until the next operation on the table, lookups may move the entry to an earlier
+     * deleted slot. \f$O(\alpha)\f$
+     * @param key Key whose corresponding data value is to be found
+     * @return \b Data* pointer to the value in the table, \a nullptr if the key is absent
+     */
+    Data* find(const lookup_key_t<Key> &key) noexcept;
+
+    /**@brief Insert an entry if the key is absent
+     * @details The data is constructed in its slot from \a args, nothing is constructed when the key
+     * is already present. \f$O(\alpha)\f$
+     * @param key Key for the entry, copied into the table only when inserted
+     * @param args Arguments of the constructor of \a Data
+     * @return \b std::pair of the pointer to the value of the key and \b true if it was inserted
+     * @exception std::runtime_error Unable to resize the table
+     */
+    template<typename... Args>
+    std::pair<Data*, bool> try_emplace(const lookup_key_t<Key> &key, Args&&... args);
+
+    /**@brief Insert an entry built from \a args if its key is absent
+     * @details The entry is constructed as a \a std::pair<Key, Data> from \a args and moved into its
+     * slot. \f$O(\alpha)\f$
+     * @param args Arguments of the constructor of \a std::pair<Key, Data>
+     * @return \b std::pair of the pointer to the value of the key and \b true if it was inserted
+     * @exception std::runtime_error Unable to resize the table
+     */
+    template<typename... Args>
+    std::pair<Data*, bool> emplace(Args&&... args);
+
+    /**@brief Access the data of \a key
+     * @details Inserts a default constructed \a Data when the key is absent. \f$O(\alpha)\f$
+     * @param key Key whose corresponding data value is to be accessed
+     * @return \b Data& reference to the value in the table
+     * @exception std::runtime_error Unable to resize the table
+     */
+    Data& operator[](const lookup_key_t<Key> &key);
+
+    /**@brief Probe length distribution
+     * @details Entry \a d is the number of elements found after \a d probes past their home slot, the
+     * number of slots a successful lookup reads is one more. Entries still in the old table of an
+     * incremental resize are not counted. \f$O(capacity + n \cdot probes)\f$
+     * @return \b std::vector of the counts
+     */
+    std::vector<size_t> probe_histogram() const;
 
 
     /** @brief Iterator for the hash table
@@ -0,0 +1,306 @@
+#include"pooled_hash_table.hpp"
+
+// Node Pool
+
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+PooledHashTable<Key, Data, Hash>::NodePool::NodePool(NodePool &&other) noexcept :
+    slabs(std::move(other.slabs)), free_list(std::exchange(other.free_list, nullptr)),
+    used(std::exchange(other.used, 0)) {
+    other.slabs.clear();
+}
+
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+typename PooledHashTable<Key, Data, Hash>::NodePool& PooledHashTable<Key, Data, Hash>::NodePool::operator=(NodePool &&other) noexcept {
+    std::swap(slabs, other.slabs);
+    std::swap(free_list, other.free_list);
+    std::swap(used, other.used);
+    return *this;
+}
+
+/*
+ * The nodes still in use have been released by the table before
+ */
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+PooledHashTable<Key, Data, Hash>::NodePool::~NodePool() {
+    for(auto [slab, count]: slabs) {
+        std::allocator<Node>().deallocate(slab, count);
+    }
+}
+
+/*
+ * Pops the free list, else bumps the last slab, else opens a slab twice the size of the last one
+ */
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+template<typename... Args>
+typename PooledHashTable<Key, Data, Hash>::Node* PooledHashTable<Key, Data, Hash>::NodePool::acquire(Args&&... args) {
+    Node* node;
+    if(free_list != nullptr) {
+        FreeNode* free = free_list;
+        free_list = free->next;
+        std::destroy_at(free);
+        node = reinterpret_cast<Node*>(free);
+    } else {
+        if(slabs.empty() || used == slabs.back().second) {
+            size_t count = slabs.empty() ? MIN_SLAB : std::min(MAX_SLAB, 2 * slabs.back().second);
+            try {
+                slabs.emplace_back(std::allocator<Node>().allocate(count), count);
+            } catch(const std::bad_alloc& e) {
+                throw std::runtime_error("Unable to allocate a node");
+            }
+            used = 0;
+        }
+        node = slabs.back().first + used++;
+    }
+    try {
+        return std::construct_at(node, std::forward<Args>(args)...);
+    } catch(...) {
+        free_list = std::construct_at(reinterpret_cast<FreeNode*>(node), free_list);
+        throw;
+    }
+}
+
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+void PooledHashTable<Key, Data, Hash>::NodePool::release(Node* node) noexcept {
+    std::destroy_at(node);
+    free_list = std::construct_at(reinterpret_cast<FreeNode*>(node), free_list);
+}
+
+// Private Functions
+
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+size_t PooledHashTable<Key, Data, Hash>::hash(const lookup_key_t<Key> &key) const {
+    return hasher(key);
+}
+
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+typename PooledHashTable<Key, Data, Hash>::Node* PooledHashTable<Key, Data, Hash>::find_node(const lookup_key_t<Key> &key, size_t hash_val) const noexcept {
+    if(capacity == 0) return nullptr;
+    for(Node* node = buckets[hash_val & (capacity - 1)]; node != nullptr; node = node->next) {
+        if(node->hash_val == hash_val && node->key == key) return node;
+    }
+    return nullptr;
+}
+
+/*
+ * Relinks every node into new_capacity buckets using the stored hashes
+ */
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+void PooledHashTable<Key, Data, Hash>::rehash(size_t new_capacity) {
+    Node** new_buckets;
+    try {
+        new_buckets = new Node*[new_capacity]();
+    } catch(const std::bad_alloc& e) {
+        throw std::runtime_error("Unable to resize the table");
+    }
+    for(size_t i = 0; i < capacity; i++) {
+        for(Node* node = buckets[i]; node != nullptr;) {
+            Node* next = node->next;
+            Node* &head = new_buckets[node->hash_val & (new_capacity - 1)];
+            node->next = head;
+            head = node;
+            node = next;
+        }
+    }
+    delete[] buckets;
+    buckets = new_buckets;
+    capacity = new_capacity;
+}
+
+/*
+ * Links a node for a key known to be absent at the head of its chain, the arguments after the hash
+ * construct the key and the data of the node
+ */
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+template<typename... Args>
+typename PooledHashTable<Key, Data, Hash>::Node* PooledHashTable<Key, Data, Hash>::emplace_new(size_t hash_val, Args&&... args) {
+    if(capacity == 0 || _size + 1 > load_factor * capacity) {
+        rehash(capacity == 0 ? DEFAULT_CAPACITY : capacity * 2);
+    }
+    Node* &head = buckets[hash_val & (capacity - 1)];
+    head = pool.acquire(head, hash_val, std::forward<Args>(args)...);
+    _size++;
+    return head;
+}
+
+// Constructors and Destructors
+
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+PooledHashTable<Key, Data, Hash>::PooledHashTable(size_t capacity, float load_factor, Hash hasher) : hasher(std::move(hasher)) {
+    if(!(load_factor > 0) || load_factor == std::numeric_limits<float>::infinity())
+        throw std::invalid_argument("Invalid load factor for the table");
+    this->load_factor = load_factor;
+    size_t buckets_needed = DEFAULT_CAPACITY;
+    while(load_factor * buckets_needed < capacity) buckets_needed *= 2;
+    rehash(buckets_needed);
+}
+
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+PooledHashTable<Key, Data, Hash>::PooledHashTable(const PooledHashTable &other) :
+    PooledHashTable(other._size, other.load_factor, other.hasher) {
+    for(size_t i = 0; i < other.capacity; i++) {
+        for(Node* node = other.buckets[i]; node != nullptr; node = node->next) {
+            insert(node->key, node->data);
+        }
+    }
+}
+
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+PooledHashTable<Key, Data, Hash>::PooledHashTable(PooledHashTable &&other) noexcept :
+    buckets(std::exchange(other.buckets, nullptr)), pool(std::move(other.pool)), hasher(other.hasher),
+    load_factor(other.load_factor), capacity(std::exchange(other.capacity, 0)),
+    _size(std::exchange(other._size, 0)) {}
+
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+PooledHashTable<Key, Data, Hash>& PooledHashTable<Key, Data, Hash>::operator=(PooledHashTable other) noexcept {
+    std::swap(buckets, other.buckets);
+    std::swap(pool, other.pool);
+    std::swap(hasher, other.hasher);
+    std::swap(load_factor, other.load_factor);
+    std::swap(capacity, other.capacity);
+    std::swap(_size, other._size);
+    return *this;
+}
+
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+PooledHashTable<Key, Data, Hash>::~PooledHashTable() {
+    clear();
+    delete[] buckets;
+}
+
+// Operations
+
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+void PooledHashTable<Key, Data, Hash>::clear() noexcept {
+    for(size_t i = 0; i < capacity; i++) {
+        for(Node* node = buckets[i]; node != nullptr;) {
+            Node* next = node->next;
+            pool.release(node);
+            node = next;
+        }
+        buckets[i] = nullptr;
+    }
+    _size = 0;
+}
+
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+bool PooledHashTable<Key, Data, Hash>::contains_key(const lookup_key_t<Key> &key) const noexcept {
+    return find_node(key, hash(key)) != nullptr;
+}
+
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+bool PooledHashTable<Key, Data, Hash>::insert(Key key, Data data) {
+    size_t hash_val = hash(key);
+    if(find_node(key, hash_val) != nullptr) return false;
+    emplace_new(hash_val, std::move(key), std::move(data));
+    return true;
+}
+
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+bool PooledHashTable<Key, Data, Hash>::insert(std::pair<Key, Data> element) {
+    return insert(std::move(element.first), std::move(element.second));
+}
+
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+Data* PooledHashTable<Key, Data, Hash>::find(const lookup_key_t<Key> &key) noexcept {
+    Node* node = find_node(key, hash(key));
+    return node == nullptr ? nullptr : &node->data;
+}
+
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+const Data* PooledHashTable<Key, Data, Hash>::find(const lookup_key_t<Key> &key) const noexcept {
+    Node* node = find_node(key, hash(key));
+    return node == nullptr ? nullptr : &node->data;
+}
+
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+template<typename... Args>
+std::pair<Data*, bool> PooledHashTable<Key, Data, Hash>::try_emplace(const lookup_key_t<Key> &key, Args&&... args) {
+    size_t hash_val = hash(key);
+    if(Node* node = find_node(key, hash_val)) return {&node->data, false};
+    return {&emplace_new(hash_val, Key(key), std::forward<Args>(args)...)->data, true};
+}
+
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+template<typename... Args>
+std::pair<Data*, bool> PooledHashTable<Key, Data, Hash>::emplace(Args&&... args) {
+    std::pair<Key, Data> entry(std::forward<Args>(args)...);
+    size_t hash_val = hash(entry.first);
+    if(Node* node = find_node(entry.first, hash_val)) return {&node->data, false};
+    return {&emplace_new(hash_val, std::move(entry.first), std::move(entry.second))->data, true};
+}
+
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+Data& PooledHashTable<Key, Data, Hash>::operator[](const lookup_key_t<Key> &key) {
+    return *try_emplace(key).first;
+}
+
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+std::optional<Data> PooledHashTable<Key, Data, Hash>::get(const lookup_key_t<Key> &key) const {
+    const Data* data = find(key);
+    if(data == nullptr) return std::nullopt;
+    return std::optional<Data>{*data};
+}
+
+/*
+ * Walks the chain through the link pointing at the node so that unlinking needs no previous node
+ */
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+std::optional<Data> PooledHashTable<Key, Data, Hash>::remove(const lookup_key_t<Key> &key) {
+    if(capacity == 0) return std::nullopt;
+    size_t hash_val = hash(key);
+    for(Node** link = &buckets[hash_val & (capacity - 1)]; *link != nullptr; link = &(*link)->next) {
+        Node* node = *link;
+        if(node->hash_val == hash_val && node->key == key) {
+            std::optional<Data> ret{std::move(node->data)};
+            *link = node->next;
+            pool.release(node);
+            _size--;
+            return ret;
+        }
+    }
+    return std::nullopt;
+}
+
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+bool PooledHashTable<Key, Data, Hash>::update(const lookup_key_t<Key> &key, Data new_data) {
+    Data* data = find(key);
+    if(data == nullptr) return false;
+    *data = std::move(new_data);
+    return true;
+}
+
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+std::vector<std::pair<Key, Data>> PooledHashTable<Key, Data, Hash>::key_value() const {
+    std::vector<std::pair<Key, Data>> entries;
+    entries.reserve(_size);
+    for(size_t i = 0; i < capacity; i++) {
+        for(Node* node = buckets[i]; node != nullptr; node = node->next) {
+            entries.emplace_back(node->key, node->data);
+        }
+    }
+    return entries;
+}
+
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+std::vector<Key> PooledHashTable<Key, Data, Hash>::keys() const {
+    std::vector<Key> entries;
+    entries.reserve(_size);
+    for(size_t i = 0; i < capacity; i++) {
+        for(Node* node = buckets[i]; node != nullptr; node = node->next) {
+            entries.push_back(node->key);
+        }
+    }
+    return entries;
+}
+
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+std::vector<Data> PooledHashTable<Key, Data, Hash>::values() const {
+    std::vector<Data> entries;
+    entries.reserve(_size);
+    for(size_t i = 0; i < capacity; i++) {
+        for(Node* node = buckets[i]; node != nullptr; node = node->next) {
+            entries.push_back(node->data);
+        }
+    }
+    return entries;
+}
@@ -0,0 +1,284 @@
+/**
+ * @file pooled_hash_table.hpp
+ * @brief Generic Hash Table with intrusive chaining and pooled nodes
+ * @details PooledHashTable template class implementing a chained Hash Table whose nodes are carved out
+ * of slabs instead of being allocated one by one
+ * @author atishek22 <kumaratishek22@gmail.com>
+ * @date Jul 2021
+ * @warning Not thread safe
+ */
+
+#ifndef DATA_STRUCTURES_POOLED_HASH_TABLE_HPP
+#define DATA_STRUCTURES_POOLED_HASH_TABLE_HPP
+
+#include<stdexcept>
+#include<cstdint>
+#include<limits>
+#include<memory>
+#include<optional>
+#include<utility>
+#include<vector>
+
+#include"../../Utils/hashable.hpp"
+#include"../../Utils/hash.hpp"
+
+/**@brief PooledHashTable Template Class
+ * @details Hash table using separate chaining with a single pointer per bucket and singly linked nodes
+ * holding the entry, its hash and the next pointer. Nodes come from slabs of increasing size and
+ * removed nodes go to a free list, so an insert is a pointer pop rather than a heap allocation and
+ * the chains of a table stay close in memory. A lookup walks its chain once and compares the stored
+ * hash before the key.
+ *
+ * The number of buckets is a power of two, the table doubles once there are more entries than
+ * \a load_factor times the buckets and relinks the existing nodes without copying them.
+ *
+ * @tparam Key Hashable Key data type
+ * @tparam Data Type of data to be stored by the table
+ * @tparam Hash Hash function of the keys and their lookup type, see \a hashing::WyHash
+ *
+ * @warning Not thread safe
+ */
+template<typename Key, typename Data, KeyHasher<Key> Hash = hashing::WyHash>
+class PooledHashTable {
+private:
+    static constexpr size_t DEFAULT_CAPACITY = 16;
+    static constexpr float DEFAULT_LOAD_FACTOR = 1.0;
+    static constexpr size_t MIN_SLAB = 64;
+    static constexpr size_t MAX_SLAB = 4096;
+
+    struct Node {
+        Node* next;
+        size_t hash_val;
+        Key key;
+        Data data;
+
+        template<typename K, typename... Args>
+        Node(Node* next, size_t hash_val, K &&key, Args&&... args) :
+            next(next), hash_val(hash_val), key(std::forward<K>(key)), data(std::forward<Args>(args)...) {}
+    };
+
+    /*
+     * Slab allocator of nodes, the free list is threaded through the released nodes
+     */
+    class NodePool {
+    private:
+        struct FreeNode {
+            FreeNode* next;
+        };
+
+        std::vector<std::pair<Node*, size_t>> slabs{};
+        FreeNode* free_list = nullptr;
+        size_t used = 0;
+
+    public:
+        NodePool() = default;
+        NodePool(const NodePool&) = delete;
+        NodePool& operator=(const NodePool&) = delete;
+        NodePool(NodePool &&other) noexcept;
+        NodePool& operator=(NodePool &&other) noexcept;
+        ~NodePool();
+
+        template<typename... Args>
+        Node* acquire(Args&&... args);
+
+        void release(Node* node) noexcept;
+    };
+
+    Node** buckets = nullptr;
+    NodePool pool;
+    Hash hasher;
+    float load_factor;
+    size_t capacity = 0, _size = 0;
+
+    /* Private Functions */
+
+    size_t hash(const lookup_key_t<Key> &key) const;
+
+    Node* find_node(const lookup_key_t<Key> &key, size_t hash_val) const noexcept;
+
+    void rehash(size_t new_capacity);
+
+    template<typename... Args>
+    Node* emplace_new(size_t hash_val, Args&&... args);
+
+public:
+    /**@brief Default constructor
+     * @details Creates an empty hash table with room for \a capacity elements before it grows
+     * @param capacity Number of elements the table holds without growing
+     * @param load_factor \f$(\alpha)\f$ largest average length of the chains
+     * @param hasher Hash function, e.g. a seeded \a hashing::WyHash
+     * @tparam Key Hashable Key data type
+     * @tparam Data Type of data to be stored by the table
+     * @tparam Hash Hash function
+     * @exception std::invalid_argument Invalid \a load_factor
+     * @exception std::runtime_error Unable to allocate the table
+     */
+    explicit PooledHashTable(size_t capacity = DEFAULT_CAPACITY, float load_factor = DEFAULT_LOAD_FACTOR,
+                             Hash hasher = Hash());
+
+    /**@brief Copy constructor
+     * @param other table to be copied
+     */
+    PooledHashTable(const PooledHashTable &other);
+
+    /**@brief Move constructor
+     * @param other table to be moved, left empty
+     */
+    PooledHashTable(PooledHashTable &&other) noexcept;
+
+    /**@brief Assignment
+     * @param other table to be copied or moved
+     * @return reference to this table
+     */
+    PooledHashTable& operator=(PooledHashTable other) noexcept;
+
+    /**@brief Destructor
+     * @details Clears the table and releases the slabs
+     */
+    ~PooledHashTable();
+
+    /**@brief Get the number of elements from the table
+     * @details \f$O(1)\f$
+     * @return \b size_t number of elements in the table
+     */
+    size_t size() const noexcept {
+        return _size;
+    }
+
+    /**@brief Check if the table is empty
+     * @details \f$O(1)\f$
+     * @return \b Boolean \b true if the table is empty
+     */
+    bool empty() const noexcept {
+        return _size == 0;
+    }
+
+    /**@brief Number of buckets of the table
+     * @details Always a power of two
+     * @return \b size_t number of buckets
+     */
+    size_t bucket_count() const noexcept {
+        return capacity;
+    }
+
+    /**@brief Clear the table
+     * @details Removes all the elements, the buckets and the pooled nodes are kept for reuse
+     */
+    void clear() noexcept;
+
+    /**@brief Check if the table contains the \a key
+     * @details \f$O(\alpha)\f$
+     * @param key Key that needs to be checked
+     * @return \b Boolean \b true if the key is present in the table
+     */
+    bool contains_key(const lookup_key_t<Key> &key) const noexcept;
+
+    /**@brief Insert an entry in the table
+     * @details Nothing is changed when the key is already present. \f$O(1)\f$ amortised
+     * @param key Key for the entry
+     * @param data Data element of the entry
+     * @return \b Boolean \b true if the entry was inserted
+     * @exception std::runtime_error Unable to allocate a node or to grow the table
+     */
+    bool insert(Key key, Data data);
+
+    /**@brief Insert an entry in the table
+     * @details \f$O(1)\f$ amortised
+     * @param element \a std::pair containing the key and data values.
+     * @return \b Boolean \b true if the entry was inserted
+     * @exception std::runtime_error Unable to allocate a node or to grow the table
+     */
+    bool insert(std::pair<Key, Data> element);
+
+    /**@brief Get element using \a key
+     * @details Get the \a data value to the corresponding \a key value. If the key doesn't exist
+     * \a std::nullopt is returned. \f$O(\alpha)\f$
+     * @param key Key whose corresponding data value is to be found
+     * @return \b Data value wrapped in \a std::optional if the key is present else \b std::nullopt
+     */
+    std::optional<Data> get(const lookup_key_t<Key> &key) const;
+
+    /**@brief Remove an element from \a key
+     * @details Unlinks the node and returns it to the pool. \f$O(\alpha)\f$
+     * @param key Key whose corresponding element is to be removed
+     * @return \b Data value wrapped in \a std::optional if the key is removed else \b std::nullopt
+     */
+    std::optional<Data> remove(const lookup_key_t<Key> &key);
+
+    /**@brief Update an element value
+     * @details Update the element data value corresponding to the key value
+     * \f$O(\alpha)\f$
+     * @param key Key value whose corresponding data value is to be updated
+     * @param new_data Updated data value
+     * @return \b Boolean \b true if the value is updated successfully
+     */
+    bool update(const lookup_key_t<Key> &key, Data new_data);
+
+    /**@brief Find the data of \a key
+     * @details Looks the key up without copying the value. String keys are looked up through a
+     * \a std::string_view, so a view or a literal doesn't allocate a temporary key. The pointer
+     * stays valid until the entry is removed. \f$O(\alpha)\f$
+     * @param key Key whose corresponding data value is to be found
+     * @return \b Data* pointer to the value in the table, \a nullptr if the key is absent
+     */
+    Data* find(const lookup_key_t<Key> &key) noexcept;
+
+    /**@brief Find the data of \a key
+     * @details \f$O(\alpha)\f$
+     * @param key Key whose corresponding data value is to be found
+     * @return \b const \b Data* pointer to the value in the table, \a nullptr if the key is absent
+     */
+    const Data* find(const lookup_key_t<Key> &key) const noexcept;
+
+    /**@brief Insert an entry if the key is absent
+     * @details The data is constructed in its node from \a args, nothing is constructed when the key
+     * is already present. \f$O(\alpha)\f$
+     * @param key Key for the entry, copied into the table only when inserted
+     * @param args Arguments of the constructor of \a Data
+     * @return \b std::pair of the pointer to the value of the key and \b true if it was inserted
+     * @exception std::runtime_error Unable to grow the table
+     */
+    template<typename... Args>
+    std::pair<Data*, bool> try_emplace(const lookup_key_t<Key> &key, Args&&... args);
+
+    /**@brief Insert an entry built from \a args if its key is absent
+     * @details The entry is constructed as a \a std::pair<Key, Data> from \a args and moved into the
+     * table. \f$O(\alpha)\f$
+     * @param args Arguments of the constructor of \a std::pair<Key, Data>
+     * @return \b std::pair of the pointer to the value of the key and \b true if it was inserted
+     * @exception std::runtime_error Unable to grow the table
+     */
+    template<typename... Args>
+    std::pair<Data*, bool> emplace(Args&&... args);
+
+    /**@brief Access the data of \a key
+     * @details Inserts a default constructed \a Data when the key is absent. \f$O(\alpha)\f$
+     * @param key Key whose corresponding data value is to be accessed
+     * @return \b Data& reference to the value in the table
+     * @exception std::runtime_error Unable to grow the table
+     */
+    Data& operator[](const lookup_key_t<Key> &key);
+
+    /**
+     * @brief Key-Value pairs from the table
+     * @details In bucket order. \f$O(n + buckets)\f$
+     * @return \b std::vector of the entries
+     */
+    std::vector<std::pair<Key, Data>> key_value() const;
+
+    /**
+     * @brief Keys from the table
+     * @details In bucket order. \f$O(n + buckets)\f$
+     * @return \b std::vector of the keys
+     */
+    std::vector<Key> keys() const;
+
+    /**
+     * @brief Values from the table
+     * @details In bucket order. \f$O(n + buckets)\f$
+     * @return \b std::vector of the values
+     */
+    std::vector<Data> values() const;
+};
+
+#endif //DATA_STRUCTURES_POOLED_HASH_TABLE_HPP
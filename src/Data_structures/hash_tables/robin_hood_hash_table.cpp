@@ -0,0 +1,311 @@
+#include"robin_hood_hash_table.hpp"
+
+// Private Functions
+
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+size_t RobinHoodHashTable<Key, Data, Hash>::hash(const lookup_key_t<Key> &key) const {
+    return hasher(key);
+}
+
+/*
+ * Slot of the key, capacity when it isn't there. An entry at distance d sits d - 1 slots after its
+ * home, so only the entries at the probe's own distance can match, and an entry nearer its home ends
+ * the run the key would be in
+ */
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+size_t RobinHoodHashTable<Key, Data, Hash>::find_index(const lookup_key_t<Key> &key) const {
+    if(capacity == 0) return 0;
+    size_t mask = capacity - 1;
+    for(size_t i = hash(key) & mask, d = 1; ; i = (i + 1) & mask, d++) {
+        if(distance[i] < d) return capacity;
+        if(distance[i] == d && slots[i].first == key) return i;
+    }
+}
+
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+void RobinHoodHashTable<Key, Data, Hash>::allocate(size_t new_capacity) {
+    try {
+        distance = new uint32_t[new_capacity]();
+        try {
+            slots = std::allocator<Slot>().allocate(new_capacity);
+        } catch(const std::bad_alloc& e) {
+            delete[] distance;
+            throw;
+        }
+    } catch(const std::bad_alloc& e) {
+        distance = nullptr;
+        slots = nullptr;
+        capacity = resize_threshold = 0;
+        throw std::runtime_error("Unable to allocate the table");
+    }
+    capacity = new_capacity;
+    resize_threshold = std::min(capacity - 1, (size_t) (load_factor * capacity));
+}
+
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+void RobinHoodHashTable<Key, Data, Hash>::deallocate() {
+    if(distance == nullptr) return;
+    clear();
+    delete[] distance;
+    std::allocator<Slot>().deallocate(slots, capacity);
+    distance = nullptr;
+    slots = nullptr;
+    capacity = resize_threshold = 0;
+}
+
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+void RobinHoodHashTable<Key, Data, Hash>::rehash(size_t new_capacity) {
+    uint32_t* old_distance = distance;
+    Slot* old_slots = slots;
+    size_t old_capacity = capacity, old_threshold = resize_threshold;
+    try {
+        allocate(new_capacity);
+    } catch(const std::runtime_error& e) {
+        distance = old_distance;
+        slots = old_slots;
+        capacity = old_capacity;
+        resize_threshold = old_threshold;
+        throw std::runtime_error("Unable to resize the table");
+    }
+    for(size_t i = 0; i < old_capacity; i++) {
+        if(old_distance[i] == 0) continue;
+        place(std::move(old_slots[i]), hash(old_slots[i].first));
+        std::destroy_at(old_slots + i);
+    }
+    if(old_distance != nullptr) {
+        delete[] old_distance;
+        std::allocator<Slot>().deallocate(old_slots, old_capacity);
+    }
+}
+
+/*
+ * Robin Hood insertion of a key known to be absent, the carried entry swaps with any resident closer
+ * to its home. Returns the slot the new entry ends up in, the first one it is put down at
+ */
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+size_t RobinHoodHashTable<Key, Data, Hash>::place(Slot &&slot, size_t hash_val) {
+    size_t mask = capacity - 1, placed = capacity;
+    Slot carried(std::move(slot));
+    uint32_t d = 1;
+    for(size_t i = hash_val & mask; ; i = (i + 1) & mask, d++) {
+        if(distance[i] == 0) {
+            std::construct_at(slots + i, std::move(carried));
+            distance[i] = d;
+            return placed == capacity ? i : placed;
+        }
+        if(distance[i] < d) {
+            std::swap(carried, slots[i]);
+            std::swap(d, distance[i]);
+            if(placed == capacity) placed = i;
+        }
+    }
+}
+
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+size_t RobinHoodHashTable<Key, Data, Hash>::emplace_new(Slot &&slot, size_t hash_val) {
+    if(_size >= resize_threshold) rehash(capacity == 0 ? DEFAULT_CAPACITY : capacity * 2);
+    size_t i = place(std::move(slot), hash_val);
+    _size++;
+    return i;
+}
+
+// Constructors and Destructors
+
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+RobinHoodHashTable<Key, Data, Hash>::RobinHoodHashTable(size_t capacity, float load_factor, Hash hasher) : hasher(std::move(hasher)) {
+    if(!(load_factor > 0 && load_factor < 1)) throw std::invalid_argument("Invalid load factor for the table");
+    this->load_factor = load_factor;
+    size_t slots_needed = DEFAULT_CAPACITY;
+    while((size_t) (load_factor * slots_needed) < capacity) slots_needed *= 2;
+    allocate(slots_needed);
+}
+
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+RobinHoodHashTable<Key, Data, Hash>::RobinHoodHashTable(const RobinHoodHashTable &other) :
+    hasher(other.hasher), load_factor(other.load_factor) {
+    if(other.capacity == 0) return;
+    allocate(other.capacity);
+    size_t i = 0;
+    try {
+        for(; i < capacity; i++) {
+            if(other.distance[i] != 0) std::construct_at(slots + i, other.slots[i]);
+        }
+    } catch(...) {
+        while(i-- > 0) {
+            if(other.distance[i] != 0) std::destroy_at(slots + i);
+        }
+        delete[] distance;
+        std::allocator<Slot>().deallocate(slots, capacity);
+        throw;
+    }
+    std::copy(other.distance, other.distance + capacity, distance);
+    _size = other._size;
+}
+
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+RobinHoodHashTable<Key, Data, Hash>::RobinHoodHashTable(RobinHoodHashTable &&other) noexcept :
+    distance(std::exchange(other.distance, nullptr)), slots(std::exchange(other.slots, nullptr)),
+    hasher(other.hasher), load_factor(other.load_factor), capacity(std::exchange(other.capacity, 0)),
+    _size(std::exchange(other._size, 0)), resize_threshold(std::exchange(other.resize_threshold, 0)) {}
+
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+RobinHoodHashTable<Key, Data, Hash>& RobinHoodHashTable<Key, Data, Hash>::operator=(RobinHoodHashTable other) noexcept {
+    std::swap(distance, other.distance);
+    std::swap(slots, other.slots);
+    std::swap(hasher, other.hasher);
+    std::swap(load_factor, other.load_factor);
+    std::swap(capacity, other.capacity);
+    std::swap(_size, other._size);
+    std::swap(resize_threshold, other.resize_threshold);
+    return *this;
+}
+
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+RobinHoodHashTable<Key, Data, Hash>::~RobinHoodHashTable() {
+    deallocate();
+}
+
+// Operations
+
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+void RobinHoodHashTable<Key, Data, Hash>::clear() noexcept {
+    for(size_t i = 0; i < capacity; i++) {
+        if(distance[i] != 0) std::destroy_at(slots + i);
+        distance[i] = 0;
+    }
+    _size = 0;
+}
+
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+bool RobinHoodHashTable<Key, Data, Hash>::contains_key(const lookup_key_t<Key> &key) const noexcept {
+    return find_index(key) != capacity;
+}
+
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+bool RobinHoodHashTable<Key, Data, Hash>::insert(Key key, Data data) {
+    if(find_index(key) != capacity) return false;
+    size_t hash_val = hash(key);
+    emplace_new(Slot(std::move(key), std::move(data)), hash_val);
+    return true;
+}
+
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+bool RobinHoodHashTable<Key, Data, Hash>::insert(std::pair<Key, Data> element) {
+    return insert(std::move(element.first), std::move(element.second));
+}
+
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+std::optional<Data> RobinHoodHashTable<Key, Data, Hash>::get(const lookup_key_t<Key> &key) const {
+    size_t slot = find_index(key);
+    if(slot == capacity) return std::nullopt;
+    return std::optional<Data>{slots[slot].second};
+}
+
+/*
+ * Backward shift: the entries after the removed one move back a slot until an empty slot or an entry
+ * already at its home, every shifted entry gets one slot closer to home
+ */
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+std::optional<Data> RobinHoodHashTable<Key, Data, Hash>::remove(const lookup_key_t<Key> &key) {
+    size_t slot = find_index(key);
+    if(slot == capacity) return std::nullopt;
+    std::optional<Data> ret{std::move(slots[slot].second)};
+    size_t mask = capacity - 1;
+    size_t i = slot;
+    for(size_t next = (i + 1) & mask; distance[next] > 1; i = next, next = (next + 1) & mask) {
+        slots[i] = std::move(slots[next]);
+        distance[i] = distance[next] - 1;
+    }
+    std::destroy_at(slots + i);
+    distance[i] = 0;
+    _size--;
+    return ret;
+}
+
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+bool RobinHoodHashTable<Key, Data, Hash>::update(const lookup_key_t<Key> &key, Data new_data) {
+    size_t slot = find_index(key);
+    if(slot == capacity) return false;
+    slots[slot].second = std::move(new_data);
+    return true;
+}
+
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+Data* RobinHoodHashTable<Key, Data, Hash>::find(const lookup_key_t<Key> &key) noexcept {
+    size_t slot = find_index(key);
+    return slot == capacity ? nullptr : &slots[slot].second;
+}
+
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+const Data* RobinHoodHashTable<Key, Data, Hash>::find(const lookup_key_t<Key> &key) const noexcept {
+    size_t slot = find_index(key);
+    return slot == capacity ? nullptr : &slots[slot].second;
+}
+
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+template<typename... Args>
+std::pair<Data*, bool> RobinHoodHashTable<Key, Data, Hash>::try_emplace(const lookup_key_t<Key> &key, Args&&... args) {
+    size_t hash_val = hash(key);
+    size_t slot = find_index(key);
+    if(slot != capacity) return {&slots[slot].second, false};
+    slot = emplace_new(Slot(std::piecewise_construct, std::forward_as_tuple(key),
+                            std::forward_as_tuple(std::forward<Args>(args)...)), hash_val);
+    return {&slots[slot].second, true};
+}
+
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+template<typename... Args>
+std::pair<Data*, bool> RobinHoodHashTable<Key, Data, Hash>::emplace(Args&&... args) {
+    Slot entry(std::forward<Args>(args)...);
+    size_t hash_val = hash(entry.first);
+    size_t slot = find_index(entry.first);
+    if(slot != capacity) return {&slots[slot].second, false};
+    slot = emplace_new(std::move(entry), hash_val);
+    return {&slots[slot].second, true};
+}
+
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+Data& RobinHoodHashTable<Key, Data, Hash>::operator[](const lookup_key_t<Key> &key) {
+    return *try_emplace(key).first;
+}
+
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+std::vector<size_t> RobinHoodHashTable<Key, Data, Hash>::probe_histogram() const {
+    std::vector<size_t> histogram;
+    for(size_t i = 0; i < capacity; i++) {
+        if(distance[i] == 0) continue;
+        if(distance[i] > histogram.size()) histogram.resize(distance[i], 0);
+        histogram[distance[i] - 1]++;
+    }
+    return histogram;
+}
+
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+std::vector<std::pair<Key, Data>> RobinHoodHashTable<Key, Data, Hash>::key_value() const {
+    std::vector<std::pair<Key, Data>> entries;
+    entries.reserve(_size);
+    for(size_t i = 0; i < capacity; i++) {
+        if(distance[i] != 0) entries.push_back(slots[i]);
+    }
+    return entries;
+}
+
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+std::vector<Key> RobinHoodHashTable<Key, Data, Hash>::keys() const {
+    std::vector<Key> entries;
+    entries.reserve(_size);
+    for(size_t i = 0; i < capacity; i++) {
+        if(distance[i] != 0) entries.push_back(slots[i].first);
+    }
+    return entries;
+}
+
+template<typename Key, typename Data, KeyHasher<Key> Hash>
+std::vector<Data> RobinHoodHashTable<Key, Data, Hash>::values() const {
+    std::vector<Data> entries;
+    entries.reserve(_size);
+    for(size_t i = 0; i < capacity; i++) {
+        if(distance[i] != 0) entries.push_back(slots[i].second);
+    }
+    return entries;
+}
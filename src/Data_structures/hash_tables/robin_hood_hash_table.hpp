@@ -0,0 +1,265 @@
+/**@file robin_hood_hash_table.hpp
+ * @brief Generic Hash Table with Robin Hood open addressing
+ * @details RobinHoodHashTable template class implementing a Hash Table with linear probing, Robin Hood
+ * insertion and backward shift deletion
+ * @author atishek22 <kumaratishek22@gmail.com>
+ * @date Jul 2021
+ * @warning Not thread safe
+ */
+
+#ifndef DATA_STRUCTURES_ROBIN_HOOD_HASH_TABLE_HPP
+#define DATA_STRUCTURES_ROBIN_HOOD_HASH_TABLE_HPP
+
+#include<stdexcept>
+#include<functional>
+#include<cstdint>
+#include<limits>
+#include<memory>
+#include<optional>
+#include<tuple>
+#include<utility>
+#include<vector>
+
+#include"../../Utils/hashable.hpp"
+#include"../../Utils/hash.hpp"
+
+/**@brief RobinHoodHashTable Template Class
+ * @details Open addressing with linear probing over a power of two table. Every slot stores the
+ * distance of its entry from the entry's home slot. An insert that meets an entry closer to its home
+ * than the one being placed swaps them and carries on with the displaced entry ("takes from the
+ * rich"), so the distances along a run never drop by more than one and their variance stays small.
+ *
+ * That ordering lets a lookup stop as soon as it meets an entry closer to home than the probe, and a
+ * removal shifts the following entries of the run back by one slot instead of leaving a tombstone,
+ * so the table never degrades under insert and remove churn.
+ *
+ * @tparam Key Hashable Key data type
+ * @tparam Data Type of data to be stored by the table
+ * @tparam Hash Hash function of the keys and their lookup type, see \a hashing::WyHash
+ *
+ * @warning Not thread safe
+ */
+template<typename Key, typename Data, KeyHasher<Key> Hash = hashing::WyHash>
+class RobinHoodHashTable {
+
+private:
+    static constexpr size_t DEFAULT_CAPACITY = 16;
+    static constexpr float DEFAULT_LOAD_FACTOR = 0.875;
+
+    using Slot = std::pair<Key, Data>;
+
+    /*
+     * distance[i] is 0 for an empty slot, else one more than the distance of slots[i] from its home
+     */
+    uint32_t* distance = nullptr;
+    Slot* slots = nullptr;
+    Hash hasher;
+    float load_factor;
+    size_t capacity = 0, _size = 0, resize_threshold = 0;
+
+    /* Private Functions */
+
+    size_t hash(const lookup_key_t<Key> &key) const;
+
+    size_t find_index(const lookup_key_t<Key> &key) const;
+
+    void allocate(size_t capacity);
+
+    void deallocate();
+
+    void rehash(size_t new_capacity);
+
+    size_t place(Slot &&slot, size_t hash_val);
+
+    size_t emplace_new(Slot &&slot, size_t hash_val);
+
+public:
+    /**@brief Default constructor
+     * @details Creates an empty hash table with room for \a capacity elements before it grows
+     * @param capacity Number of elements the table holds without growing
+     * @param load_factor \f$(\alpha)\f$ largest ratio of the number of elements to the number of slots
+     * @param hasher Hash function, e.g. a seeded \a hashing::WyHash
+     * @tparam Key Hashable Key data type
+     * @tparam Data Type of data to be stored by the table
+     * @tparam Hash Hash function
+     * @exception std::invalid_argument Invalid \a load_factor, it should be in \f$(0, 1)\f$
+     * @exception std::runtime_error Unable to allocate the table
+     */
+    explicit RobinHoodHashTable(size_t capacity = DEFAULT_CAPACITY, float load_factor = DEFAULT_LOAD_FACTOR,
+                                Hash hasher = Hash());
+
+    /**@brief Copy constructor
+     * @param other table to be copied
+     */
+    RobinHoodHashTable(const RobinHoodHashTable &other);
+
+    /**@brief Move constructor
+     * @param other table to be moved, left empty
+     */
+    RobinHoodHashTable(RobinHoodHashTable &&other) noexcept;
+
+    /**@brief Assignment
+     * @param other table to be copied or moved
+     * @return reference to this table
+     */
+    RobinHoodHashTable& operator=(RobinHoodHashTable other) noexcept;
+
+    /**@brief Destructor
+     * @details Clears and deallocates the table
+     */
+    ~RobinHoodHashTable();
+
+    /**@brief Get the number of elements from the table
+     * @details \f$O(1)\f$
+     * @return \b size_t number of elements in the table
+     */
+    size_t size() const noexcept {
+        return _size;
+    }
+
+    /**@brief Check if the table is empty
+     * @details \f$O(1)\f$
+     * @return \b Boolean \b true if the table is empty
+     */
+    bool empty() const noexcept {
+        return _size == 0;
+    }
+
+    /**@brief Number of slots of the table
+     * @details Always a power of two
+     * @return \b size_t number of slots
+     */
+    size_t bucket_count() const noexcept {
+        return capacity;
+    }
+
+    /**@brief Clear the table
+     * @details Removes all the elements but maintains the table capacity
+     */
+    void clear() noexcept;
+
+    /**@brief Check if the table contains the \a key
+     * @details \f$O(1)\f$ expected, a miss stops at the first entry closer to its home than the probe
+     * @param key Key that needs to be checked
+     * @return \b Boolean \b true if the key is present in the table
+     */
+    bool contains_key(const lookup_key_t<Key> &key) const noexcept;
+
+    /**@brief Insert an entry in the table
+     * @details Nothing is changed when the key is already present. \f$O(1)\f$ amortised
+     * @param key Key for the entry
+     * @param data Data element of the entry
+     * @return \b Boolean \b true if the entry was inserted
+     * @exception std::runtime_error Unable to grow the table
+     */
+    bool insert(Key key, Data data);
+
+    /**@brief Insert an entry in the table
+     * @details \f$O(1)\f$ amortised
+     * @param element \a std::pair containing the key and data values.
+     * @return \b Boolean \b true if the entry was inserted
+     * @exception std::runtime_error Unable to grow the table
+     */
+    bool insert(std::pair<Key, Data> element);
+
+    /**@brief Get element using \a key
+     * @details Get the \a data value to the corresponding \a key value. If the key doesn't exist
+     * \a std::nullopt is returned. \f$O(1)\f$ expected
+     * @param key Key whose corresponding data value is to be found
+     * @return \b Data value wrapped in \a std::optional if the key is present else \b std::nullopt
+     */
+    std::optional<Data> get(const lookup_key_t<Key> &key) const;
+
+    /**@brief Remove an element from \a key
+     * @details Removes the element and shifts the rest of its run back by one slot, no tombstone is
+     * left behind. \f$O(1)\f$ expected
+     *
+     * @param key Key whose corresponding element is to be removed
+     * @return \b Data value wrapped in \a std::optional if the key is removed else \b std::nullopt
+     */
+    std::optional<Data> remove(const lookup_key_t<Key> &key);
+
+    /**@brief Update an element value
+     * @details Update the element data value corresponding to the key value
+     * \f$O(1)\f$ expected
+     * @param key Key value whose corresponding data value is to be updated
+     * @param new_data Updated data value
+     * @return \b Boolean \b true if the value is updated successfully
+     */
+    bool update(const lookup_key_t<Key> &key, Data new_data);
+
+    /**@brief Find the data of \a key
+     * @details Looks the key up without copying the value. String keys are looked up through a
+     * \a std::string_view, so a view or a literal doesn't allocate a temporary key. The pointer
+     * stays valid until the next insert or remove, both may move the entry. \f$O(1)\f$ expected
+     * @param key Key whose corresponding data value is to be found
+     * @return \b Data* pointer to the value in the table, \a nullptr if the key is absent
+     */
+    Data* find(const lookup_key_t<Key> &key) noexcept;
+
+    /**@brief Find the data of \a key
+     * @details \f$O(1)\f$ expected
+     * @param key Key whose corresponding data value is to be found
+     * @return \b const \b Data* pointer to the value in the table, \a nullptr if the key is absent
+     */
+    const Data* find(const lookup_key_t<Key> &key) const noexcept;
+
+    /**@brief Insert an entry if the key is absent
+     * @details The data is constructed in its slot from \a args, nothing is constructed when the key
+     * is already present. \f$O(1)\f$ expected
+     * @param key Key for the entry, copied into the table only when inserted
+     * @param args Arguments of the constructor of \a Data
+     * @return \b std::pair of the pointer to the value of the key and \b true if it was inserted
+     * @exception std::runtime_error Unable to grow the table
+     */
+    template<typename... Args>
+    std::pair<Data*, bool> try_emplace(const lookup_key_t<Key> &key, Args&&... args);
+
+    /**@brief Insert an entry built from \a args if its key is absent
+     * @details The entry is constructed as a \a std::pair<Key, Data> from \a args and moved into the
+     * table. \f$O(1)\f$ expected
+     * @param args Arguments of the constructor of \a std::pair<Key, Data>
+     * @return \b std::pair of the pointer to the value of the key and \b true if it was inserted
+     * @exception std::runtime_error Unable to grow the table
+     */
+    template<typename... Args>
+    std::pair<Data*, bool> emplace(Args&&... args);
+
+    /**@brief Access the data of \a key
+     * @details Inserts a default constructed \a Data when the key is absent. \f$O(1)\f$ expected
+     * @param key Key whose corresponding data value is to be accessed
+     * @return \b Data& reference to the value in the table
+     * @exception std::runtime_error Unable to grow the table
+     */
+    Data& operator[](const lookup_key_t<Key> &key);
+
+    /**@brief Probe length distribution
+     * @details Entry \a d is the number of elements found \a d slots away from their home slot, the
+     * number of probes of a successful lookup is one more. \f$O(capacity)\f$
+     * @return \b std::vector of the counts
+     */
+    std::vector<size_t> probe_histogram() const;
+
+    /**
+     * @brief Key-Value pairs from the table
+     * @details In slot order. \f$O(capacity)\f$
+     * @return \b std::vector of the entries
+     */
+    std::vector<std::pair<Key, Data>> key_value() const;
+
+    /**
+     * @brief Keys from the table
+     * @details In slot order. \f$O(capacity)\f$
+     * @return \b std::vector of the keys
+     */
+    std::vector<Key> keys() const;
+
+    /**
+     * @brief Values from the table
+     * @details In slot order. \f$O(capacity)\f$
+     * @return \b std::vector of the values
+     */
+    std::vector<Data> values() const;
+};
+
+#endif //DATA_STRUCTURES_ROBIN_HOOD_HASH_TABLE_HPP
@@ -40,9 +40,9 @@ template<typename T>
 void LinkedList<T>::add_last(T element) {
     try {
         if(empty())
-            head = tail = new Node(element);
+            head = tail = new Node(std::move(element));
         else {
-            tail->next = new Node(element, tail);
+            tail->next = new Node(std::move(element), tail);
             tail = tail->next;
         }
         _size++;
@@ -56,9 +56,9 @@ template<typename T>
 void LinkedList<T>::add_first(T element) {
     try {
         if(empty())
-            head = tail = new Node(element);
+            head = tail = new Node(std::move(element));
         else {
-            head->prev = new Node(element, nullptr, head);
+            head->prev = new Node(std::move(element), nullptr, head);
             head = head->prev;
         }
         _size++;
@@ -106,7 +106,7 @@ T LinkedList<T>::peek_last() {
 template<typename T>
 T LinkedList<T>::remove_first() {
     if(empty()) throw std::runtime_error("Invalid: Empty Queue Deletion");
-    T ret = head->getData();
+    T ret = std::move(*head->getDataPtr());
     Node *temp = head;
     head = head->next;
     _size--;
@@ -121,7 +121,7 @@ T LinkedList<T>::remove_first() {
 template<typename T>
 T LinkedList<T>::remove_last() {
     if(empty()) throw std::runtime_error("Invalid: Empty Queue Deletion");
-    T ret = tail->getData();
+    T ret = std::move(*tail->getDataPtr());
     Node *temp = tail;
     tail = tail->prev;
     _size--;
@@ -140,7 +140,7 @@ T LinkedList<T>::remove_at(int index) {
     Node *trav;
 
     if(index < _size / 2) {
-        for(i = 0, head = trav; i != index; i++)
+        for(i = 0, trav = head; i != index; i++)
             trav = trav->next;
     } else {
         for(i = _size - 1, trav = tail; i != index; i--)
@@ -172,6 +172,25 @@ int LinkedList<T>::index(T element) noexcept {
     return -1;
 }
 
+template<typename T>
+template<typename Predicate>
+T* LinkedList<T>::find_if(Predicate pred) noexcept {
+    for(Node *trav = head; trav != nullptr; trav = trav->next) {
+        if(pred(*trav->getDataPtr())) return trav->getDataPtr();
+    }
+    return nullptr;
+}
+
+template<typename T>
+template<typename Predicate>
+int LinkedList<T>::index_if(Predicate pred) noexcept {
+    int index = 0;
+    for(Node *trav = head; trav != nullptr; trav = trav->next, index++) {
+        if(pred(*trav->getDataPtr())) return index;
+    }
+    return -1;
+}
+
 template<typename T>
 bool LinkedList<T>::contains(T element) noexcept {
     return index(element) != -1;
@@ -197,7 +216,7 @@ bool LinkedList<T>::update_at(int index, T val) {
     Node *trav;
 
     if(index < _size / 2) {
-        for(i = 0, head = trav; i != index; i++)
+        for(i = 0, trav = head; i != index; i++)
             trav = trav->next;
     } else {
         for(i = _size - 1, trav = tail; i != index; i--)
@@ -11,6 +11,7 @@
 #include<initializer_list>
 #include<stdexcept>
 #include<iostream>
+#include<utility>
 
 //TODO - Iterator implementation
 
@@ -30,12 +31,16 @@ private:
         Node *next;
 
         explicit Node(T d, Node *p = nullptr, Node *n = nullptr): 
-          data(d), prev(p), next(n) {}
+          data(std::move(d)), prev(p), next(n) {}
 
         T getData(){
             return data;
         }
 
+        T* getDataPtr() {
+            return &data;
+        }
+
         bool setData(T new_value) {
             data = new_value;
             return true;
@@ -193,6 +198,22 @@ public:
      */
     T operator[](int index);
 
+    /**@brief Find the first element satisfying \a pred
+     * @details \f$O(n)\f$
+     * @param pred predicate over the elements
+     * @return Pointer to the element in the list, \a nullptr if none satisfies \a pred
+     */
+    template<typename Predicate>
+    T* find_if(Predicate pred) noexcept;
+
+    /**@brief Index of the first element satisfying \a pred
+     * @details \f$O(n)\f$
+     * @param pred predicate over the elements
+     * @return Index of the element, \a -1 if none satisfies \a pred
+     */
+    template<typename Predicate>
+    int index_if(Predicate pred) noexcept;
+
     /**@brief Clear the list / Remove all elements
      * @exception std::runtime_error
      */
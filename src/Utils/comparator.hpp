@@ -0,0 +1,20 @@
+/** @file comparator.hpp
+ * @brief Comparator concept
+ * @author Atishek Kumar
+ * @date May 2021
+ */
+#ifndef DSA_CONCEPT_COMPARATOR_HPP
+#define DSA_CONCEPT_COMPARATOR_HPP
+
+#include<concepts>
+
+/**@brief Comparator concept
+ * @details Concept defining callables that can be used as the comparison callback of the
+ * comparison sorts, i.e. a predicate over two \a const references of \a T.
+ *
+ * \a compare(first, second) returns \b true when \a first should be placed after \a second.
+ */
+template<typename Compare, typename T>
+concept Comparator = std::predicate<Compare&, const T&, const T&>;
+
+#endif //DSA_CONCEPT_COMPARATOR_HPP
@@ -0,0 +1,175 @@
+/** @file hash.hpp
+ * @brief Fast hash functions for the hash tables
+ * @details wyhash style hashing of integers, strings and byte spans, optionally seeded, and
+ * hash_combine for composite keys.
+ * @author Atishek Kumar
+ * @date Jul 2021
+ */
+#ifndef DSA_UTILS_HASH_HPP
+#define DSA_UTILS_HASH_HPP
+
+#include<concepts>
+#include<cstddef>
+#include<cstdint>
+#include<cstring>
+#include<functional>
+#include<random>
+#include<span>
+#include<string_view>
+
+namespace hashing {
+
+    namespace detail {
+        inline constexpr uint64_t P0 = 0xa0761d6478bd642full;
+        inline constexpr uint64_t P1 = 0xe7037ed1a0b428dbull;
+        inline constexpr uint64_t P2 = 0x8ebc6af09c88c6e3ull;
+        inline constexpr uint64_t P3 = 0x589965cc75374cc3ull;
+
+        /*
+         * 64 x 64 -> 128 bit multiply folded back to 64 bits, every input bit reaches the output
+         */
+        inline uint64_t mix(uint64_t a, uint64_t b) noexcept {
+            unsigned __int128 r = (unsigned __int128) a * b;
+            return (uint64_t) r ^ (uint64_t) (r >> 64);
+        }
+
+        inline void multiply(uint64_t &a, uint64_t &b) noexcept {
+            unsigned __int128 r = (unsigned __int128) a * b;
+            a = (uint64_t) r;
+            b = (uint64_t) (r >> 64);
+        }
+
+        inline uint64_t read64(const unsigned char *p) noexcept {
+            uint64_t v;
+            std::memcpy(&v, p, sizeof(v));
+            return v;
+        }
+
+        inline uint64_t read32(const unsigned char *p) noexcept {
+            uint32_t v;
+            std::memcpy(&v, p, sizeof(v));
+            return v;
+        }
+
+        /*
+         * wyhash: inputs up to 16 bytes are read as two overlapping words, longer ones 16 bytes a
+         * step, or 48 bytes a step over three independent lanes above 48 bytes
+         */
+        inline uint64_t hash_bytes(const unsigned char *p, size_t length, uint64_t seed) noexcept {
+            seed ^= mix(seed ^ P0, P1);
+            uint64_t a, b;
+            if(length <= 16) {
+                if(length >= 4) {
+                    size_t middle = (length >> 3) << 2;
+                    a = (read32(p) << 32) | read32(p + middle);
+                    b = (read32(p + length - 4) << 32) | read32(p + length - 4 - middle);
+                } else if(length > 0) {
+                    a = ((uint64_t) p[0] << 16) | ((uint64_t) p[length >> 1] << 8) | p[length - 1];
+                    b = 0;
+                } else {
+                    a = b = 0;
+                }
+            } else {
+                size_t i = length;
+                if(i > 48) {
+                    uint64_t lane1 = seed, lane2 = seed;
+                    do {
+                        seed = mix(read64(p) ^ P1, read64(p + 8) ^ seed);
+                        lane1 = mix(read64(p + 16) ^ P2, read64(p + 24) ^ lane1);
+                        lane2 = mix(read64(p + 32) ^ P3, read64(p + 40) ^ lane2);
+                        p += 48;
+                        i -= 48;
+                    } while(i > 48);
+                    seed ^= lane1 ^ lane2;
+                }
+                for(; i > 16; i -= 16, p += 16) {
+                    seed = mix(read64(p) ^ P1, read64(p + 8) ^ seed);
+                }
+                a = read64(p + i - 16);
+                b = read64(p + i - 8);
+            }
+            a ^= P1;
+            b ^= seed;
+            multiply(a, b);
+            return mix(a ^ P0 ^ length, b ^ P1);
+        }
+    }
+
+    /**@brief Combine the hash of a part of a composite key into \a seed
+     * @details Order dependent: the hash of the parts \a a, \a b is
+     * \a hash_combine(hash_combine(0, a), b). \f$O(1)\f$
+     * @param seed hash of the parts so far
+     * @param value hash of the next part
+     * @return \b size_t hash of the parts including \a value
+     */
+    inline size_t hash_combine(size_t seed, size_t value) noexcept {
+        return (size_t) detail::mix(seed ^ detail::P0, value ^ detail::P1);
+    }
+
+    /**@brief wyhash style hash function
+     * @details Hashes integers, strings and byte spans with 128 bit multiply mixing, so all the bits
+     * of the result depend on all the bits of the key and a power of two table can pick its slot from
+     * the low bits. \a std::hash is the identity on the integers, which fills runs of consecutive
+     * slots with sequential keys and piles strided keys onto a few slots. Other keys are mixed from
+     * their \a std::hash.
+     *
+     * The seed salts the hash: with a random seed (see seeded()) the slots of the keys can't be
+     * predicted from outside the process, which defeats inputs crafted to collide.
+     */
+    struct WyHash {
+        uint64_t seed = 0;
+
+        WyHash() = default;
+
+        /**@brief Seeded hash
+         * @param seed salt mixed into every hash
+         */
+        explicit WyHash(uint64_t seed) noexcept : seed(seed) {}
+
+        /**@brief Hash with a random seed
+         * @return \b WyHash seeded from \a std::random_device
+         */
+        static WyHash seeded() {
+            std::random_device device;
+            return WyHash(((uint64_t) device() << 32) | device());
+        }
+
+        /**@brief Hash of an integer
+         * @details \f$O(1)\f$
+         */
+        template<std::integral T>
+        size_t operator()(T value) const noexcept {
+            uint64_t a = (uint64_t) value ^ detail::P0, b = seed ^ detail::P1;
+            detail::multiply(a, b);
+            return (size_t) detail::mix(a ^ detail::P0, b ^ detail::P1);
+        }
+
+        /**@brief Hash of a string
+         * @details Equal for a \a std::string and its \a std::string_view. \f$O(length)\f$
+         */
+        size_t operator()(std::string_view value) const noexcept {
+            return (size_t) detail::hash_bytes(reinterpret_cast<const unsigned char*>(value.data()), value.size(), seed);
+        }
+
+        /**@brief Hash of any other key with a \a std::hash
+         * @details Mixes the \a std::hash of the key like an integer, e.g. for floating point and
+         * enum keys. \f$O(1)\f$ plus the \a std::hash
+         */
+        template<typename T>
+            requires (!std::integral<T> && !std::convertible_to<const T&, std::string_view> &&
+                      !std::convertible_to<const T&, std::span<const std::byte>>) &&
+                     requires(const T &value) { {std::hash<T>{}(value)} -> std::convertible_to<size_t>; }
+        size_t operator()(const T &value) const {
+            return (*this)((uint64_t) std::hash<T>{}(value));
+        }
+
+        /**@brief Hash of a byte span
+         * @details \f$O(length)\f$
+         */
+        size_t operator()(std::span<const std::byte> value) const noexcept {
+            return (size_t) detail::hash_bytes(reinterpret_cast<const unsigned char*>(value.data()), value.size(), seed);
+        }
+    };
+}
+
+#endif //DSA_UTILS_HASH_HPP
@@ -6,6 +6,8 @@
 
 #include<concepts>
 #include<functional>
+#include<string>
+#include<string_view>
 
 /** @brief Hashable Concept
  *  @details Constraint for the Key type in the hash table to types that have a \a std::hash implementation
@@ -15,4 +17,34 @@ concept Hashable = requires(T a) {
     {std::hash<T>{}(a)} -> std::convertible_to<size_t>;
 };
 
+/** @brief Lookup type of a key
+ *  @details Type taken by the lookups of the hash tables for keys of type \a Key. Strings are looked up
+ *  through a \a std::basic_string_view, which hashes and compares like the string, so that a lookup
+ *  from a view or a literal doesn't allocate a temporary key. Other keys are looked up as themselves.
+ */
+template<typename Key>
+struct lookup_key {
+    using type = Key;
+};
+
+template<typename Char, typename Traits, typename Allocator>
+struct lookup_key<std::basic_string<Char, Traits, Allocator>> {
+    using type = std::basic_string_view<Char, Traits>;
+};
+
+/** @brief Lookup type of a key, see lookup_key
+ */
+template<typename Key>
+using lookup_key_t = typename lookup_key<Key>::type;
+
+/** @brief KeyHasher Concept
+ *  @details Constraint for the hash function of a hash table with keys of type \a Key: it hashes the
+ *  keys and their lookup type, with the same value for a key and its lookup
+ */
+template<typename Hash, typename Key>
+concept KeyHasher = requires(const Hash &hash, const Key &key, const lookup_key_t<Key> &lookup) {
+    {hash(key)} -> std::convertible_to<size_t>;
+    {hash(lookup)} -> std::convertible_to<size_t>;
+};
+
 #endif //DSA_CONCEPT_HASHABLE_HPP
@@ -0,0 +1,192 @@
+/** @file thread_pool.hpp
+ * @brief Work stealing thread pool
+ * @details Fork-join thread pool used by the parallel algorithms.
+ * @author Atishek Kumar
+ * @date May 2021
+ */
+#ifndef DSA_UTILS_THREAD_POOL_HPP
+#define DSA_UTILS_THREAD_POOL_HPP
+
+#include<atomic>
+#include<condition_variable>
+#include<deque>
+#include<functional>
+#include<memory>
+#include<mutex>
+#include<thread>
+#include<vector>
+
+/**@brief Work stealing thread pool
+ * @details Every thread owns a task deque. Tasks submitted from a pool thread go to the back of its
+ * own deque and are popped from the back (LIFO, cache friendly for divide and conquer), idle
+ * threads steal from the front of the other deques. Threads outside the pool share deque 0 and
+ * help run tasks while waiting in wait(), so a pool of \a n threads starts \a n - 1 workers.
+ *
+ * Tasks must not throw.
+ */
+class ThreadPool {
+private:
+    struct TaskQueue {
+        std::mutex lock;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    std::vector<std::unique_ptr<TaskQueue>> queues;
+    std::vector<std::thread> workers;
+    std::mutex sleep_lock;
+    std::condition_variable wake;
+    std::atomic<size_t> pending{0};
+    bool stopping = false;
+
+    inline static thread_local ThreadPool* owner = nullptr;
+    inline static thread_local size_t owner_index = 0;
+
+    size_t local_index() const noexcept {
+        return owner == this ? owner_index : 0;
+    }
+
+    bool pop(size_t i, std::function<void()> &task, bool back) {
+        std::lock_guard<std::mutex> guard(queues[i]->lock);
+        auto &tasks = queues[i]->tasks;
+        if(tasks.empty()) return false;
+        if(back) {
+            task = std::move(tasks.back());
+            tasks.pop_back();
+        } else {
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+        pending--;
+        return true;
+    }
+
+    void worker_loop(size_t i) {
+        owner = this;
+        owner_index = i;
+        while(true) {
+            if(run_pending()) continue;
+            std::unique_lock<std::mutex> guard(sleep_lock);
+            wake.wait(guard, [this] { return stopping || pending > 0; });
+            if(stopping && pending == 0) return;
+        }
+    }
+
+public:
+    /**@brief Constructor
+     * @details Creates a pool of \a threads threads including the calling thread.
+     * @param threads number of threads, \a 0 uses \a std::thread::hardware_concurrency()
+     */
+    explicit ThreadPool(size_t threads = 0) {
+        if(threads == 0) threads = std::thread::hardware_concurrency();
+        if(threads == 0) threads = 1;
+        for(size_t i = 0; i < threads; i++) {
+            queues.push_back(std::make_unique<TaskQueue>());
+        }
+        for(size_t i = 1; i < threads; i++) {
+            workers.emplace_back(&ThreadPool::worker_loop, this, i);
+        }
+    }
+
+    /**@brief Destructor
+     * @details Finishes the pending tasks and joins the workers
+     */
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> guard(sleep_lock);
+            stopping = true;
+        }
+        wake.notify_all();
+        for(auto &worker: workers) {
+            worker.join();
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**@brief Number of threads running tasks including the waiting thread
+     * @return \b size_t number of threads
+     */
+    size_t size() const noexcept {
+        return queues.size();
+    }
+
+    /**@brief Submit a task
+     * @details Pushes the task to the back of the calling thread's deque
+     * @param task callable to be run by the pool
+     */
+    void submit(std::function<void()> task) {
+        {
+            auto &queue = *queues[local_index()];
+            std::lock_guard<std::mutex> guard(queue.lock);
+            queue.tasks.push_back(std::move(task));
+            pending++;
+        }
+        { std::lock_guard<std::mutex> guard(sleep_lock); }
+        wake.notify_one();
+    }
+
+    /**@brief Run one pending task
+     * @details Pops a task from the calling thread's deque or steals one from another deque.
+     * @return \b Boolean \b true if a task was run
+     */
+    bool run_pending() {
+        std::function<void()> task;
+        size_t self = local_index(), n = queues.size();
+        bool found = pop(self, task, true);
+        for(size_t k = 1; !found && k < n; k++) {
+            found = pop((self + k) % n, task, false);
+        }
+        if(!found) return false;
+        task();
+        return true;
+    }
+
+    /**@brief Wait for a condition
+     * @details Runs pending tasks until \a done returns \b true
+     * @param done predicate checked between tasks
+     */
+    template<typename Predicate>
+        void wait(Predicate done) {
+            while(!done()) {
+                if(!run_pending()) std::this_thread::yield();
+            }
+        }
+};
+
+/**@brief Fork-join group of tasks on a ThreadPool
+ * @details Tasks can be added to the group from any thread including tasks of the same group,
+ * wait() returns once all of them have finished. The group must outlive its tasks.
+ */
+class TaskGroup {
+private:
+    ThreadPool &pool;
+    std::atomic<size_t> remaining{0};
+
+public:
+    /**@brief Constructor
+     * @param pool pool running the tasks of the group
+     */
+    explicit TaskGroup(ThreadPool &pool) : pool(pool) {}
+
+    /**@brief Add a task to the group
+     * @param task callable to be run by the pool
+     */
+    template<typename Task>
+        void run(Task task) {
+            remaining++;
+            pool.submit([this, task]() mutable {
+                task();
+                remaining--;
+            });
+        }
+
+    /**@brief Wait for the tasks of the group
+     * @details The calling thread runs pending tasks while waiting
+     */
+    void wait() {
+        pool.wait([this] { return remaining == 0; });
+    }
+};
+
+#endif //DSA_UTILS_THREAD_POOL_HPP
@@ -0,0 +1,147 @@
+#include "gtest/gtest.h"
+#include "../../../include/DSA.hpp"
+#define SIZE 200000
+
+/*
+ * Unit Tests for the Maximum Subarray Sum Algorithms
+ */
+class MaxSubarraySumTest : public ::testing::Test {
+public:
+    std::vector<long long> IntegerVector{};
+    long long Expected;
+protected:
+    void SetUp() override {
+        std::random_device rd;
+        std::default_random_engine e(rd());
+        std::uniform_int_distribution<> distInt(-1000, 990);
+        for (int i = 0; i < SIZE; i++) {
+            IntegerVector.push_back(distInt(e));
+        }
+        // reference Kadane
+        long long sum = 0;
+        Expected = IntegerVector[0];
+        for(auto x: IntegerVector) {
+            sum = std::max(sum + x, x);
+            Expected = std::max(Expected, sum);
+        }
+    }
+
+    void TearDown() override {
+        IntegerVector.clear();
+    }
+};
+
+/* ========================================== Kadane =========================================================*/
+
+TEST_F(MaxSubarraySumTest, fastNegativeFloatingPoint) {
+    std::vector<double> losses{-3.5, -1.25, -2.0};
+    ASSERT_EQ(max_subarray_sum_fast(losses), -1.25);
+    ASSERT_EQ(max_subarray_sum_fast(IntegerVector), Expected);
+}
+
+TEST_F(MaxSubarraySumTest, parallelIndices) {
+    for(size_t threads: {1, 2, 4, 7}) {
+        auto [low, high, sum] = max_subarray_sum_parallel(IntegerVector, threads);
+        ASSERT_EQ(sum, Expected);
+        ASSERT_LE(low, high);
+        ASSERT_EQ(std::accumulate(IntegerVector.begin() + low, IntegerVector.begin() + high + 1, 0ll), sum);
+    }
+    std::span<const long long> tail(IntegerVector.data() + SIZE - 10, 10);
+    auto [low, high, sum] = max_subarray_sum_parallel(tail);
+    ASSERT_EQ(std::accumulate(tail.begin() + low, tail.begin() + high + 1, 0ll), sum);
+    ASSERT_THROW(max_subarray_sum_parallel(std::vector<int>{}), std::runtime_error);
+}
+
+/* ========================================== Divide and Conquer =============================================*/
+
+TEST_F(MaxSubarraySumTest, divideAndConquer) {
+    for(size_t threads: {1, 4}) {
+        auto [low, high, sum] = max_subarray_sum(IntegerVector, threads);
+        ASSERT_EQ(sum, Expected);
+        ASSERT_EQ(std::accumulate(IntegerVector.begin() + low, IntegerVector.begin() + high + 1, 0ll), sum);
+    }
+    std::vector<double> losses{-3.5, -1.25, -2.0};
+    ASSERT_EQ(std::get<2>(max_subarray_sum(losses)), -1.25);
+    ASSERT_THROW(max_subarray_sum(std::vector<int>{}), std::runtime_error);
+}
+
+/* ========================================== Segment Tree ===================================================*/
+
+TEST_F(MaxSubarraySumTest, segmentTree) {
+    std::vector<long long> values(IntegerVector.begin(), IntegerVector.begin() + 1000);
+    MaxSubarrayTree<long long> tree(values);
+    ASSERT_EQ(std::get<2>(tree.query(0, values.size() - 1)), std::get<2>(max_subarray_sum(values)));
+    std::default_random_engine e(7);
+    std::uniform_int_distribution<size_t> index(0, values.size() - 1);
+    std::uniform_int_distribution<long long> value(-1000, 1000);
+    for(int round = 0; round < 200; round++) {
+        size_t i = index(e);
+        values[i] = value(e);
+        tree.update(i, values[i]);
+        size_t l = index(e), r = index(e);
+        if(l > r) std::swap(l, r);
+        auto [low, high, sum] = tree.query(l, r);
+        std::span<const long long> range(values.data() + l, r - l + 1);
+        ASSERT_EQ(sum, std::get<2>(max_subarray_sum(range)));
+        ASSERT_TRUE(l <= low && low <= high && high <= r);
+        ASSERT_EQ(std::accumulate(values.begin() + low, values.begin() + high + 1, 0ll), sum);
+    }
+    ASSERT_EQ(tree.at(5), values[5]);
+    ASSERT_THROW(tree.query(3, 1000), std::out_of_range);
+    ASSERT_THROW(tree.update(1000, 0), std::out_of_range);
+}
+
+/* ========================================== Subrectangle ===================================================*/
+
+TEST_F(MaxSubarraySumTest, subrectangle) {
+    std::default_random_engine e(11);
+    std::uniform_int_distribution<int> value(-50, 40);
+    for(auto [rows, cols]: {std::pair<size_t, size_t>{1, 1}, {7, 13}, {13, 7}, {20, 20}}) {
+        std::vector<int> grid(rows * cols);
+        for(auto &x: grid) x = value(e);
+        // brute force over the corners with 2D prefix sums
+        std::vector<int> prefix((rows + 1) * (cols + 1), 0);
+        for(size_t r = 0; r < rows; r++)
+            for(size_t c = 0; c < cols; c++)
+                prefix[(r + 1) * (cols + 1) + c + 1] = grid[r * cols + c] + prefix[r * (cols + 1) + c + 1]
+                        + prefix[(r + 1) * (cols + 1) + c] - prefix[r * (cols + 1) + c];
+        auto area = [&](size_t top, size_t left, size_t bottom, size_t right) {
+            return prefix[(bottom + 1) * (cols + 1) + right + 1] - prefix[top * (cols + 1) + right + 1]
+                   - prefix[(bottom + 1) * (cols + 1) + left] + prefix[top * (cols + 1) + left];
+        };
+        int expected = grid[0];
+        for(size_t top = 0; top < rows; top++)
+            for(size_t bottom = top; bottom < rows; bottom++)
+                for(size_t left = 0; left < cols; left++)
+                    for(size_t right = left; right < cols; right++)
+                        expected = std::max(expected, area(top, left, bottom, right));
+        for(size_t threads: {1, 3}) {
+            auto [top, left, bottom, right, sum] = max_subrectangle_sum(grid, rows, cols, threads);
+            ASSERT_EQ(sum, expected);
+            ASSERT_TRUE(top <= bottom && bottom < rows && left <= right && right < cols);
+            ASSERT_EQ(area(top, left, bottom, right), sum);
+        }
+    }
+    ASSERT_THROW(max_subrectangle_sum(std::vector<int>{1, 2, 3}, 2, 2), std::invalid_argument);
+}
+
+/* ========================================== Bounded Length =================================================*/
+
+TEST_F(MaxSubarraySumTest, boundedLength) {
+    std::vector<long long> values(IntegerVector.begin(), IntegerVector.begin() + 300);
+    for(auto [min_length, max_length]: {std::pair<size_t, size_t>{1, 1}, {1, 300}, {5, 20}, {50, 50}, {100, 1000}}) {
+        long long expected = std::numeric_limits<long long>::lowest();
+        for(size_t i = 0; i < values.size(); i++)
+            for(size_t length = min_length; length <= max_length && i + length <= values.size(); length++)
+                expected = std::max(expected, std::accumulate(values.begin() + i, values.begin() + i + length, 0ll));
+        auto [low, high, sum] = max_subarray_sum_bounded(values, min_length, max_length);
+        ASSERT_EQ(sum, expected);
+        ASSERT_GE(high - low + 1, min_length);
+        ASSERT_LE(high - low + 1, max_length);
+        ASSERT_EQ(std::accumulate(values.begin() + low, values.begin() + high + 1, 0ll), sum);
+    }
+    ASSERT_EQ(std::get<2>(max_subarray_sum_bounded(IntegerVector, 1, SIZE)), Expected);
+    ASSERT_THROW(max_subarray_sum_bounded(values, 0, 3), std::invalid_argument);
+    ASSERT_THROW(max_subarray_sum_bounded(values, 4, 3), std::invalid_argument);
+    ASSERT_THROW(max_subarray_sum_bounded(values, 301, 400), std::invalid_argument);
+}
@@ -0,0 +1,190 @@
+#include "gtest/gtest.h"
+#include "../../../include/DSA.hpp"
+#include <list>
+#include <numeric>
+#define SIZE 10000
+#define ADVERSARIAL_COMPARISONS 30
+
+/*
+ * Unit Tests for the Order Statistics
+ */
+class OrderStatisticsTest : public ::testing::Test {
+public:
+    std::vector<int> IntegerVector{};
+    std::vector<int> Sorted{};
+protected:
+    void SetUp() override {
+        std::random_device rd;
+        std::default_random_engine e(rd());
+        std::uniform_int_distribution<> distInt(-1000, 1000);
+        for (int i = 0; i < SIZE; i++) {
+            IntegerVector.push_back(distInt(e));
+        }
+        Sorted = IntegerVector;
+        std::sort(Sorted.begin(), Sorted.end());
+    }
+
+    void TearDown() override {
+        IntegerVector.clear();
+        Sorted.clear();
+    }
+};
+
+/* ========================================== Minimum and Maximum =========================================================*/
+
+TEST_F(OrderStatisticsTest, minmaxValEverySize) {
+    // every remainder of the vector registers and accumulators, including odd sizes
+    for(int n = 1; n <= 200; n++) {
+        std::span<const int> prefix(IntegerVector.data(), n);
+        auto [low, high] = std::minmax_element(prefix.begin(), prefix.end());
+        ASSERT_EQ(minmaxVal(prefix), std::make_pair(*low, *high));
+        ASSERT_EQ(minVal(prefix), *low);
+        ASSERT_EQ(maxVal(prefix), *high);
+        ASSERT_EQ(argMin(prefix), low - prefix.begin());
+        ASSERT_EQ(argMax(prefix), std::max_element(prefix.begin(), prefix.end()) - prefix.begin());
+    }
+    ASSERT_THROW(maxVal(std::vector<int>{}), std::runtime_error);
+}
+
+TEST_F(OrderStatisticsTest, minmaxValTypes) {
+    std::vector<double> doubles{2.5, -1.0, std::nan(""), 7.25, -3.5, 7.25};
+    ASSERT_EQ(minmaxVal(doubles), std::make_pair(-3.5, 7.25));
+    ASSERT_EQ(argMax(doubles), 3);
+    std::vector<uint8_t> bytes(1000, 7);
+    bytes[999] = 255;
+    bytes[500] = 0;
+    ASSERT_EQ(argMax(bytes), 999);
+    ASSERT_EQ(argMin(bytes), 500);
+    std::vector<std::string> strings{"b", "c", "a"};
+    ASSERT_EQ(minmaxVal(strings), std::make_pair(std::string("a"), std::string("c")));
+}
+
+/* ========================================== Selection =========================================================*/
+
+TEST_F(OrderStatisticsTest, selectElement) {
+    ASSERT_EQ(selectElement(IntegerVector, SIZE / 2), Sorted[SIZE / 2 - 1]);
+    ASSERT_THROW(selectElement(IntegerVector, 0), std::out_of_range);
+}
+
+TEST_F(OrderStatisticsTest, nthElement) {
+    for(int k: {0, 1, SIZE / 3, SIZE - 1}) {
+        std::vector<int> v = IntegerVector;
+        nthElement(v, k);
+        ASSERT_EQ(v[k], Sorted[k]);
+        for(int i = 0; i < SIZE; i++) {
+            if(i < k) ASSERT_LE(v[i], v[k]);
+            if(i > k) ASSERT_GE(v[i], v[k]);
+        }
+    }
+    nthElement(IntegerVector, 10, sorting::decreasingOrder<int>);
+    ASSERT_EQ(IntegerVector[10], Sorted[SIZE - 11]);
+    ASSERT_THROW(nthElement(IntegerVector, SIZE), std::out_of_range);
+}
+
+/*
+ * Selects v[k] of every k in ks with a comparison counting order, checks the partition around
+ * v[k] and that the comparisons stay below a linear bound
+ */
+static void selectAdversarial(const std::vector<int> &input, std::initializer_list<int> ks) {
+    std::vector<int> sorted = input;
+    std::sort(sorted.begin(), sorted.end());
+    int n = (int) input.size();
+    for(int k: ks) {
+        std::vector<int> v = input;
+        size_t comparisons = 0;
+        nthElement(v, k, [&comparisons](const int &first, const int &second) {
+            comparisons++;
+            return first > second;
+        });
+        ASSERT_EQ(v[k], sorted[k]);
+        for(int i = 0; i < n; i++) {
+            if(i < k) ASSERT_LE(v[i], v[k]);
+            if(i > k) ASSERT_GE(v[i], v[k]);
+        }
+        ASSERT_LE(comparisons, ADVERSARIAL_COMPARISONS * n);
+    }
+}
+
+TEST_F(OrderStatisticsTest, nthElementAdversarial) {
+    int n = 100000;
+    std::vector<int> organPipe(n), sawtooth(n), equal(n, 7);
+    for(int i = 0; i < n; i++) {
+        organPipe[i] = std::min(i, n - 1 - i);
+        sawtooth[i] = i % 100;
+    }
+    for(const auto &input: {organPipe, sawtooth, equal}) {
+        selectAdversarial(input, {0, 1, n / 4, n / 2, n - 2, n - 1});
+    }
+}
+
+TEST_F(OrderStatisticsTest, nthElementAdversaryComparator) {
+    // McIlroy's adversary: values are frozen only when compared, each pair of undecided values
+    // freezes the one that was the last pivot candidate, which drives median of three pivots
+    // to the end of the range. Every answer stays consistent with the final values
+    int n = 100000;
+    std::vector<int> value(n, n), v(n);
+    int solid = 0, candidate = 0;
+    size_t comparisons = 0;
+    auto adversary = [&](const int &first, const int &second) {
+        comparisons++;
+        if(value[first] == n && value[second] == n) {
+            value[first == candidate ? first : second] = solid++;
+        }
+        if(value[first] == n) candidate = first;
+        else if(value[second] == n) candidate = second;
+        return value[first] > value[second];
+    };
+    for(int k: {0, n / 2, n - 1}) {
+        std::iota(v.begin(), v.end(), 0);
+        std::fill(value.begin(), value.end(), n);
+        solid = candidate = 0;
+        comparisons = 0;
+        nthElement(v, k, adversary);
+        for(int i = 0; i < n; i++) {
+            if(i < k) ASSERT_LE(value[v[i]], value[v[k]]);
+            if(i > k) ASSERT_GE(value[v[i]], value[v[k]]);
+        }
+        ASSERT_LE(comparisons, ADVERSARIAL_COMPARISONS * n);
+    }
+}
+
+/* ========================================== Top K =========================================================*/
+
+TEST_F(OrderStatisticsTest, partialSort) {
+    // heap selection up to SIZE / PARTIAL_SORT_HEAP_RATIO, then nthElement, then a full sort
+    for(int k: {100, SIZE / 2, SIZE}) {
+        std::vector<int> v = IntegerVector;
+        partialSort(v, k);
+        for(int i = 0; i < k; i++) {
+            ASSERT_EQ(v[i], Sorted[i]);
+        }
+        for(int i = k; i < SIZE; i++) {
+            ASSERT_GE(v[i], Sorted[k - 1]);
+        }
+        std::sort(v.begin(), v.end());
+        ASSERT_EQ(v, Sorted);
+    }
+}
+
+TEST_F(OrderStatisticsTest, topK) {
+    std::list<int> scores(IntegerVector.begin(), IntegerVector.end());
+    std::vector<int> top = topK(scores, 100);
+    ASSERT_EQ(top.size(), 100);
+    for(int i = 0; i < 100; i++) {
+        ASSERT_EQ(top[i], Sorted[SIZE - 1 - i]);
+    }
+    std::vector<int> bottom = topK(IntegerVector, 5, sorting::increasingOrder<int>);
+    ASSERT_EQ(bottom, std::vector<int>(Sorted.begin(), Sorted.begin() + 5));
+}
+
+TEST_F(OrderStatisticsTest, streamingTopK) {
+    StreamingTopK<int> top(10);
+    ASSERT_THROW(top.threshold(), std::runtime_error);
+    top.push(IntegerVector.begin(), IntegerVector.begin() + SIZE / 2);
+    for(int i = SIZE / 2; i < SIZE; i++) {
+        top.push(IntegerVector[i]);
+    }
+    ASSERT_EQ(top.size(), 10);
+    ASSERT_EQ(top.threshold(), Sorted[SIZE - 10]);
+    ASSERT_EQ(top.sorted(), std::vector<int>(Sorted.rbegin(), Sorted.rbegin() + 10));
+}
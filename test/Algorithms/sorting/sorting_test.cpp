@@ -180,6 +180,503 @@ TEST_F(SortingTest, randomisedQuickSortDecreasingDouble) {
     }
 }
 
+/* =========================================== Intro Sort ========================================================== */
+
+TEST_F(SortingTest, introSortIncreasingInteger) {
+    introSort(IntegerVector);
+    for(int i = 0; i < SIZE - 1; i++) {
+        ASSERT_GE(IntegerVector[i+1], IntegerVector[i]);
+    }
+}
+
+TEST_F(SortingTest, introSortDecreasingInteger) {
+    introSort(IntegerVector, sorting::decreasingOrder<int>);
+    for(int i = 0; i < SIZE - 1; i++) {
+        ASSERT_LE(IntegerVector[i+1], IntegerVector[i]);
+    }
+}
+
+TEST_F(SortingTest, introSortIncreasingDouble) {
+    introSort(DoubleVector, sorting::increasingOrder<double>);
+    for(int i = 0;i < SIZE - 1; i++) {
+        ASSERT_GE(DoubleVector[i+1], DoubleVector[i]);
+    }
+}
+
+TEST_F(SortingTest, introSortDecreasingDouble) {
+    introSort(DoubleVector, sorting::decreasingOrder<double>);
+    for(int i = 0; i < SIZE - 1; i++) {
+        ASSERT_LE(DoubleVector[i+1], DoubleVector[i]);
+    }
+}
+
+TEST_F(SortingTest, introSortOrderedInput) {
+    std::vector<int> sorted(SIZE * 100), reversed(SIZE * 100), equal(SIZE * 100, 7);
+    for(int i = 0; i < SIZE * 100; i++) {
+        sorted[i] = i;
+        reversed[i] = SIZE * 100 - i;
+    }
+    introSort(sorted);
+    introSort(reversed);
+    introSort(equal);
+    for(int i = 0; i < SIZE * 100 - 1; i++) {
+        ASSERT_GE(sorted[i+1], sorted[i]);
+        ASSERT_GE(reversed[i+1], reversed[i]);
+        ASSERT_EQ(equal[i], 7);
+    }
+}
+
+/* =========================================== Pattern Defeating Quick Sort ========================================== */
+
+TEST_F(SortingTest, pdqSortIncreasingInteger) {
+    pdqSort(IntegerVector);
+    for(int i = 0; i < SIZE - 1; i++) {
+        ASSERT_GE(IntegerVector[i+1], IntegerVector[i]);
+    }
+}
+
+TEST_F(SortingTest, pdqSortDecreasingInteger) {
+    pdqSort(IntegerVector, sorting::decreasingOrder<int>);
+    for(int i = 0; i < SIZE - 1; i++) {
+        ASSERT_LE(IntegerVector[i+1], IntegerVector[i]);
+    }
+}
+
+TEST_F(SortingTest, pdqSortIncreasingDouble) {
+    pdqSort(DoubleVector, sorting::increasingOrder<double>);
+    for(int i = 0;i < SIZE - 1; i++) {
+        ASSERT_GE(DoubleVector[i+1], DoubleVector[i]);
+    }
+}
+
+TEST_F(SortingTest, pdqSortDecreasingDouble) {
+    pdqSort(DoubleVector, sorting::decreasingOrder<double>);
+    for(int i = 0; i < SIZE - 1; i++) {
+        ASSERT_LE(DoubleVector[i+1], DoubleVector[i]);
+    }
+}
+
+TEST_F(SortingTest, pdqSortDuplicateKeys) {
+    std::vector<int> expected(SIZE, 0);
+    for(int i = 0; i < SIZE; i++) {
+        IntegerVector[i] = (IntegerVector[i] & 7);
+        expected[IntegerVector[i]]++;
+    }
+    std::vector<std::string> strings;
+    for(int i = 0; i < SIZE; i++) {
+        strings.push_back(std::to_string(IntegerVector[i]));
+    }
+    pdqSort(IntegerVector);
+    pdqSort(strings, sorting::decreasingOrder<std::string>);
+    for(int i = 0; i < SIZE - 1; i++) {
+        ASSERT_GE(IntegerVector[i+1], IntegerVector[i]);
+        ASSERT_LE(strings[i+1], strings[i]);
+    }
+    for(int i = 0; i < SIZE; i++) {
+        expected[IntegerVector[i]]--;
+    }
+    for(int k = 0; k < 8; k++) {
+        ASSERT_EQ(expected[k], 0);
+    }
+}
+
+TEST_F(SortingTest, pdqSortOrderedInput) {
+    std::vector<int> sorted(SIZE * 100), reversed(SIZE * 100);
+    for(int i = 0; i < SIZE * 100; i++) {
+        sorted[i] = i;
+        reversed[i] = SIZE * 100 - i;
+    }
+    pdqSort(sorted);
+    pdqSort(reversed);
+    for(int i = 0; i < SIZE * 100 - 1; i++) {
+        ASSERT_GE(sorted[i+1], sorted[i]);
+        ASSERT_GE(reversed[i+1], reversed[i]);
+    }
+}
+
+TEST_F(SortingTest, threeWayPartitionInteger) {
+    for(auto &val: IntegerVector) {
+        val &= 7;
+    }
+    IntegerVector.back() = 3;
+    auto [lt, gt] = threeWayPartition(IntegerVector, sorting::increasingOrder<int>, 0, SIZE - 1);
+    for(int i = 0; i < SIZE; i++) {
+        if(i < lt) ASSERT_LT(IntegerVector[i], 3);
+        else if(i <= gt) ASSERT_EQ(IntegerVector[i], 3);
+        else ASSERT_GT(IntegerVector[i], 3);
+    }
+}
+
+/* =========================================== Tim Sort ========================================================== */
+
+TEST_F(SortingTest, timSortIncreasingInteger) {
+    timSort(IntegerVector);
+    for(int i = 0; i < SIZE - 1; i++) {
+        ASSERT_GE(IntegerVector[i+1], IntegerVector[i]);
+    }
+}
+
+TEST_F(SortingTest, timSortDecreasingInteger) {
+    timSort(IntegerVector, sorting::decreasingOrder<int>);
+    for(int i = 0; i < SIZE - 1; i++) {
+        ASSERT_LE(IntegerVector[i+1], IntegerVector[i]);
+    }
+}
+
+TEST_F(SortingTest, timSortIncreasingDouble) {
+    timSort(DoubleVector, sorting::increasingOrder<double>);
+    for(int i = 0;i < SIZE - 1; i++) {
+        ASSERT_GE(DoubleVector[i+1], DoubleVector[i]);
+    }
+}
+
+TEST_F(SortingTest, timSortDecreasingDouble) {
+    timSort(DoubleVector, sorting::decreasingOrder<double>);
+    for(int i = 0; i < SIZE - 1; i++) {
+        ASSERT_LE(DoubleVector[i+1], DoubleVector[i]);
+    }
+}
+
+TEST_F(SortingTest, timSortPartiallySorted) {
+    // ascending and descending runs with a few out of place elements
+    std::sort(IntegerVector.begin(), IntegerVector.begin() + SIZE / 2);
+    std::sort(IntegerVector.begin() + SIZE / 2, IntegerVector.end(), std::greater<int>());
+    for(int i = 0; i < SIZE; i += 97) {
+        std::swap(IntegerVector[i], IntegerVector[SIZE - 1 - i]);
+    }
+    timSort(IntegerVector);
+    for(int i = 0; i < SIZE - 1; i++) {
+        ASSERT_GE(IntegerVector[i+1], IntegerVector[i]);
+    }
+}
+
+TEST_F(SortingTest, stableSortsKeepEqualKeysInOrder) {
+    auto byKey = [](const std::pair<int, int> &first, const std::pair<int, int> &second) {
+        return first.first > second.first;
+    };
+    std::vector<std::pair<int, int>> records;
+    for(int i = 0; i < SIZE; i++) {
+        records.emplace_back(IntegerVector[i] & 15, i);
+    }
+    auto merged = records;
+    timSort(records, byKey);
+    mergeSort(merged, byKey);
+    for(int i = 0; i < SIZE - 1; i++) {
+        ASSERT_LE(records[i].first, records[i+1].first);
+        if(records[i].first == records[i+1].first) ASSERT_LT(records[i].second, records[i+1].second);
+    }
+    ASSERT_EQ(records, merged);
+}
+
+/* =========================================== Parallel Sort ========================================================== */
+
+TEST_F(SortingTest, parallelQuickSortIncreasingInteger) {
+    parallelSort(IntegerVector, sorting::increasingOrder<int>, parallel_sorting::QUICK_SORT, 4, 256);
+    for(int i = 0; i < SIZE - 1; i++) {
+        ASSERT_GE(IntegerVector[i+1], IntegerVector[i]);
+    }
+}
+
+TEST_F(SortingTest, parallelQuickSortDecreasingDouble) {
+    parallelSort(DoubleVector, sorting::decreasingOrder<double>, parallel_sorting::QUICK_SORT, 4, 256);
+    for(int i = 0; i < SIZE - 1; i++) {
+        ASSERT_LE(DoubleVector[i+1], DoubleVector[i]);
+    }
+}
+
+TEST_F(SortingTest, parallelMergeSortIncreasingInteger) {
+    parallelSort(IntegerVector, sorting::increasingOrder<int>, parallel_sorting::MERGE_SORT, 3, 256);
+    for(int i = 0; i < SIZE - 1; i++) {
+        ASSERT_GE(IntegerVector[i+1], IntegerVector[i]);
+    }
+}
+
+TEST_F(SortingTest, parallelMergeSortStable) {
+    auto byKey = [](const std::pair<int, int> &first, const std::pair<int, int> &second) {
+        return first.first > second.first;
+    };
+    std::vector<std::pair<int, int>> records;
+    for(int i = 0; i < SIZE; i++) {
+        records.emplace_back(IntegerVector[i] & 15, i);
+    }
+    parallelSort(records, byKey, parallel_sorting::MERGE_SORT, 5, 128);
+    for(int i = 0; i < SIZE - 1; i++) {
+        ASSERT_LE(records[i].first, records[i+1].first);
+        if(records[i].first == records[i+1].first) ASSERT_LT(records[i].second, records[i+1].second);
+    }
+}
+
+/* =========================================== Sorting Network ========================================================== */
+
+TEST_F(SortingTest, networkSortBlocks) {
+    std::vector<int64_t> longs(IntegerVector.begin(), IntegerVector.end());
+    std::vector<float> floats(IntegerVector.begin(), IntegerVector.end());
+    for(int n = 1; n <= sorting::NETWORK_SORT_THRESHOLD; n++) {
+        std::vector<int> ints(IntegerVector.begin() + n, IntegerVector.begin() + 2 * n);
+        std::vector<double> doubles(DoubleVector.begin(), DoubleVector.begin() + n);
+        // the blocks must be sorted permutations of the input and the rest left as it was
+        auto expectedInts = ints;
+        auto expectedDoubles = doubles;
+        auto expectedLongs = longs;
+        auto expectedFloats = floats;
+        std::sort(expectedInts.begin(), expectedInts.end());
+        std::sort(expectedDoubles.begin(), expectedDoubles.end(), std::greater<double>());
+        std::sort(expectedLongs.begin() + n, expectedLongs.begin() + 2 * n);
+        std::sort(expectedFloats.begin() + n, expectedFloats.begin() + 2 * n, std::greater<float>());
+        networkSort(ints, sorting::increasingOrder<int>, 0, n - 1);
+        networkSort(doubles, sorting::decreasingOrder<double>, 0, n - 1);
+        networkSort(longs, sorting::increasingOrder<int64_t>, n, 2 * n - 1);
+        networkSort(floats, sorting::decreasingOrder<float>, n, 2 * n - 1);
+        ASSERT_EQ(ints, expectedInts);
+        ASSERT_EQ(doubles, expectedDoubles);
+        ASSERT_EQ(longs, expectedLongs);
+        ASSERT_EQ(floats, expectedFloats);
+    }
+    ASSERT_THROW(networkSort(IntegerVector, sorting::increasingOrder<int>, 0, sorting::NETWORK_SORT_THRESHOLD), std::invalid_argument);
+}
+
+/* =========================================== LSD Radix Sort ========================================================== */
+
+TEST_F(SortingTest, lsdRadixSortIncreasingInteger) {
+    lsdRadixSort(IntegerVector);
+    for(int i = 0; i < SIZE - 1; i++) {
+        ASSERT_GE(IntegerVector[i+1], IntegerVector[i]);
+    }
+}
+
+TEST_F(SortingTest, lsdRadixSortDecreasingInteger) {
+    lsdRadixSort(IntegerVector, linear_sorting::DECREASING_ORDER);
+    for(int i = 0; i < SIZE - 1; i++) {
+        ASSERT_LE(IntegerVector[i+1], IntegerVector[i]);
+    }
+}
+
+TEST_F(SortingTest, lsdRadixSortIncreasingDouble) {
+    for(int i = 0; i < SIZE; i += 3) {
+        DoubleVector[i] = -DoubleVector[i];
+    }
+    DoubleVector[1] = -std::numeric_limits<double>::infinity();
+    DoubleVector[2] = std::numeric_limits<double>::infinity();
+    lsdRadixSort(DoubleVector);
+    for(int i = 0; i < SIZE - 1; i++) {
+        ASSERT_GE(DoubleVector[i+1], DoubleVector[i]);
+    }
+}
+
+TEST_F(SortingTest, lsdRadixSortUnsignedAndFloat) {
+    std::vector<uint64_t> timestamps;
+    std::vector<float> floats;
+    for(int i = 0; i < SIZE; i++) {
+        timestamps.push_back(((uint64_t) (unsigned) IntegerVector[i] << 32) | (unsigned) IntegerVector[SIZE - 1 - i]);
+        floats.push_back((float) IntegerVector[i] / 1000);
+    }
+    lsdRadixSort(timestamps);
+    lsdRadixSort(floats, linear_sorting::DECREASING_ORDER);
+    for(int i = 0; i < SIZE - 1; i++) {
+        ASSERT_GE(timestamps[i+1], timestamps[i]);
+        ASSERT_LE(floats[i+1], floats[i]);
+    }
+}
+
+/* =========================================== Counting Sort ========================================================== */
+
+TEST_F(SortingTest, countingSortUnsigned) {
+    std::vector<unsigned> values;
+    for(int i = 0; i < SIZE; i++) values.push_back((unsigned) IntegerVector[i] % 1000);
+    values = countingSort(values, 999u, linear_sorting::DECREASING_ORDER);
+    for(int i = 0; i < SIZE - 1; i++) {
+        ASSERT_GE(values[i], values[i+1]);
+    }
+}
+
+/*
+ * Enough elements for countingParts() to give every one of the 4 threads its own histogram and
+ * scatter range
+ */
+static const size_t PARALLEL_COUNTING_SIZE = 4 * linear_sorting::COUNTING_SORT_GRAIN;
+
+TEST_F(SortingTest, rangeCountingSortParallel) {
+    std::default_random_engine e(1234);
+    std::uniform_int_distribution<int> dist(-499, 499);
+    std::vector<int> values(PARALLEL_COUNTING_SIZE);
+    for(auto &x: values) x = dist(e);
+    std::vector<int> expected = values;
+    std::sort(expected.begin(), expected.end());
+    rangeCountingSort(values, -499, 499, linear_sorting::INCREASING_ORDER, 4);
+    ASSERT_EQ(values, expected);
+    std::sort(expected.begin(), expected.end(), std::greater<>());
+    rangeCountingSort(values, -499, 499, linear_sorting::DECREASING_ORDER, 4);
+    ASSERT_EQ(values, expected);
+    ASSERT_THROW(rangeCountingSort(values, 0, 499), std::invalid_argument);
+}
+
+TEST_F(SortingTest, countingSortByKeyStable) {
+    struct Row {
+        uint16_t category;
+        int id;
+    };
+    std::default_random_engine e(1234);
+    std::uniform_int_distribution<int> dist(0, 65535);
+    std::vector<Row> rows;
+    for(int i = 0; i < (int) PARALLEL_COUNTING_SIZE; i++) rows.push_back({(uint16_t) dist(e), i});
+    countingSortByKey(rows, &Row::category, 0, 65535, linear_sorting::INCREASING_ORDER, 4);
+    for(size_t i = 0; i + 1 < rows.size(); i++) {
+        ASSERT_LE(rows[i].category, rows[i+1].category);
+        if(rows[i].category == rows[i+1].category) ASSERT_LT(rows[i].id, rows[i+1].id);
+    }
+}
+
+/* =========================================== Bucket Sort ========================================================== */
+
+TEST_F(SortingTest, bucketSortIncreasingDouble) {
+    DoubleVector = bucketSort(DoubleVector);
+    for(int i = 0; i < SIZE - 1; i++) {
+        ASSERT_GE(DoubleVector[i+1], DoubleVector[i]);
+    }
+}
+
+TEST_F(SortingTest, bucketSortDecreasingSkewedFloat) {
+    std::vector<float> floats;
+    for(int i = 0; i < SIZE; i++) {
+        // clustered values, infinities and NaNs
+        floats.push_back(i % 100 == 0 ? std::numeric_limits<float>::infinity() : 
+                         i % 101 == 0 ? std::numeric_limits<float>::quiet_NaN() : 
+                         std::pow((float) IntegerVector[i] / std::numeric_limits<int>::max(), 9.0f));
+    }
+    floats = bucketSort(floats, linear_sorting::DECREASING_ORDER);
+    ASSERT_EQ(floats.size(), SIZE);
+    int nans = 0;
+    for(int i = 0; i < SIZE - 1; i++) {
+        if(std::isnan(floats[i+1])) nans++;
+        else ASSERT_LE(floats[i+1], floats[i]);
+    }
+    ASSERT_EQ(nans, 99);
+}
+
+TEST_F(SortingTest, bucketSortIncreasingLongDouble) {
+    std::vector<long double> values(DoubleVector.begin(), DoubleVector.end());
+    std::vector<long double> expected = values;
+    std::sort(expected.begin(), expected.end());
+    ASSERT_EQ(bucketSort(values), expected);
+}
+
+/* =========================================== MSD Radix Sort ========================================================== */
+
+TEST_F(SortingTest, msdRadixSortIncreasingString) {
+    for(int i = 0; i < SIZE; i++) {
+        // shared prefixes, empty strings and characters above 127
+        StringVector.push_back("https://host/" + std::to_string((unsigned) IntegerVector[i] % 977));
+        StringVector.push_back(std::string((unsigned) IntegerVector[i] % 4, (char) (IntegerVector[i] >> 24)));
+    }
+    std::vector<std::string> expected = StringVector;
+    std::sort(expected.begin(), expected.end());
+    msdRadixSort(StringVector);
+    ASSERT_EQ(StringVector, expected);
+}
+
+TEST_F(SortingTest, msdRadixSortParallelDecreasingStringView) {
+    for(int i = 0; i < SIZE; i++) {
+        StringVector.push_back(std::to_string(IntegerVector[i]));
+    }
+    std::vector<std::string_view> views(StringVector.begin(), StringVector.end());
+    std::vector<std::string_view> expected = views;
+    std::sort(expected.begin(), expected.end(), std::greater<>());
+    msdRadixSort(views, linear_sorting::DECREASING_ORDER, 4);
+    ASSERT_EQ(views, expected);
+}
+
+TEST_F(SortingTest, msdRadixSortParallelSharedPrefix) {
+    for(int i = 0; i < SIZE; i++) {
+        // every key starts with the same 27 characters, some keys are duplicates
+        StringVector.push_back("https://example.com/api/v1/" + std::to_string((unsigned) IntegerVector[i] % (SIZE / 2)));
+    }
+    std::vector<std::string> expected = StringVector;
+    std::sort(expected.begin(), expected.end());
+    msdRadixSort(StringVector, linear_sorting::INCREASING_ORDER, 4);
+    ASSERT_EQ(StringVector, expected);
+    std::vector<std::string> same(SIZE, "https://example.com/");
+    msdRadixSort(same, linear_sorting::INCREASING_ORDER, 4);
+    ASSERT_EQ(same, std::vector<std::string>(SIZE, "https://example.com/"));
+}
+
+/* =========================================== Key Sorting ========================================================== */
+
+TEST_F(SortingTest, argsortIncreasingInteger) {
+    for(auto &x: IntegerVector) x %= 100;
+    std::vector<int> indices = argsort(IntegerVector);
+    for(int i = 0; i < SIZE - 1; i++) {
+        ASSERT_LE(IntegerVector[indices[i]], IntegerVector[indices[i+1]]);
+        if(IntegerVector[indices[i]] == IntegerVector[indices[i+1]]) ASSERT_LT(indices[i], indices[i+1]);
+    }
+}
+
+TEST_F(SortingTest, argsortSignedZeroStable) {
+    std::vector<double> zeros = {0.0, -0.0, 0.0, -0.0, -1.0};
+    ASSERT_EQ(argsort(zeros), (std::vector<int>{4, 0, 1, 2, 3}));
+    ASSERT_EQ(argsort(zeros, sorting::DecreasingOrder<double>{}), (std::vector<int>{0, 1, 2, 3, 4}));
+    std::vector<float> floats = {-0.0f, 0.0f, -0.0f};
+    std::vector<int> ids = {0, 1, 2};
+    sortByKey(floats, ids);
+    ASSERT_EQ(ids, (std::vector<int>{0, 1, 2}));
+}
+
+TEST_F(SortingTest, argsortComparatorStable) {
+    for(auto &x: DoubleVector) x = (double) ((long long) (x / 1e300) % 10);
+    std::vector<int> indices = argsort(DoubleVector, [](double a, double b) { return a < b; });
+    for(int i = 0; i < SIZE - 1; i++) {
+        ASSERT_GE(DoubleVector[indices[i]], DoubleVector[indices[i+1]]);
+        if(DoubleVector[indices[i]] == DoubleVector[indices[i+1]]) ASSERT_LT(indices[i], indices[i+1]);
+    }
+}
+
+TEST_F(SortingTest, sortByKeyParallelArrays) {
+    std::vector<int> original = IntegerVector;
+    std::vector<int> positions(SIZE);
+    std::iota(positions.begin(), positions.end(), 0);
+    std::vector<std::string> names;
+    for(int i = 0; i < SIZE; i++) names.push_back(std::to_string(i));
+    sortByKey(IntegerVector, sorting::decreasingOrder<int>, positions, names);
+    for(int i = 0; i < SIZE; i++) {
+        ASSERT_EQ(IntegerVector[i], original[positions[i]]);
+        ASSERT_EQ(names[i], std::to_string(positions[i]));
+        if(i < SIZE - 1) ASSERT_GE(IntegerVector[i], IntegerVector[i+1]);
+    }
+    std::vector<int> shorter(SIZE - 1);
+    ASSERT_THROW(sortByKey(IntegerVector, shorter), std::invalid_argument);
+}
+
+TEST_F(SortingTest, sortByMemberProjection) {
+    struct Record {
+        long long ts;
+        int id;
+        char payload[100];
+    };
+    std::vector<Record> records;
+    for(int i = 0; i < SIZE; i++) records.push_back({IntegerVector[i] % 1000, i, {}});
+    sortBy(records, sorting::increasingOrder<long long>, &Record::ts);
+    for(int i = 0; i < SIZE - 1; i++) {
+        ASSERT_LE(records[i].ts, records[i+1].ts);
+        if(records[i].ts == records[i+1].ts) ASSERT_LT(records[i].id, records[i+1].id);
+    }
+}
+
+/* =========================================== Comparators ========================================================== */
+
+TEST_F(SortingTest, quickSortLambdaComparator) {
+    quickSort(IntegerVector, [](const int &first, const int &second) { return first < second; });
+    for(int i = 0; i < SIZE - 1; i++) {
+        ASSERT_LE(IntegerVector[i+1], IntegerVector[i]);
+    }
+}
+
+TEST_F(SortingTest, mergeSortFunctionComparator) {
+    std::function<bool(int, int)> compare = [](int first, int second) { return first > second; };
+    mergeSort(IntegerVector, compare);
+    for(int i = 0; i < SIZE - 1; i++) {
+        ASSERT_GE(IntegerVector[i+1], IntegerVector[i]);
+    }
+}
+
 int main(int argc, char** argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
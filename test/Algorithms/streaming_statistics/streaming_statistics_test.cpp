@@ -0,0 +1,87 @@
+#include "gtest/gtest.h"
+#include "../../../include/DSA.hpp"
+#define SIZE 100000
+
+/*
+ * Unit Tests for the Streaming Statistics
+ */
+class StreamingStatisticsTest : public ::testing::Test {
+public:
+    std::vector<double> Latencies{};
+    std::vector<double> Sorted{};
+
+    // exact normalised rank of a value
+    double exactRank(double value) {
+        return (double) (std::upper_bound(Sorted.begin(), Sorted.end(), value) - Sorted.begin()) / SIZE;
+    }
+protected:
+    void SetUp() override {
+        std::random_device rd;
+        std::default_random_engine e(rd());
+        std::lognormal_distribution<> distLatency(0, 1);
+        for (int i = 0; i < SIZE; i++) {
+            Latencies.push_back(distLatency(e));
+        }
+        Sorted = Latencies;
+        std::sort(Sorted.begin(), Sorted.end());
+    }
+
+    void TearDown() override {
+        Latencies.clear();
+        Sorted.clear();
+    }
+};
+
+/* ========================================== KLL Sketch =========================================================*/
+
+TEST_F(StreamingStatisticsTest, kllQuantiles) {
+    KLLSketch<double> sketch;
+    ASSERT_THROW(sketch.quantile(0.5), std::runtime_error);
+    for(double latency: Latencies) sketch.insert(latency);
+    ASSERT_EQ(sketch.count(), SIZE);
+    ASSERT_LT(sketch.retained(), 1000);
+    ASSERT_EQ(sketch.quantile(0), Sorted.front());
+    ASSERT_EQ(sketch.quantile(1), Sorted.back());
+    for(double q: {0.1, 0.5, 0.9, 0.99}) {
+        ASSERT_NEAR(exactRank(sketch.quantile(q)), q, 0.02);
+        ASSERT_NEAR(sketch.rank(Sorted[(int) (q * SIZE)]), q, 0.02);
+    }
+    ASSERT_THROW(sketch.quantile(1.5), std::out_of_range);
+}
+
+TEST_F(StreamingStatisticsTest, kllMerge) {
+    std::vector<KLLSketch<double>> perThread(4);
+    for(int i = 0; i < SIZE; i++) perThread[i % 4].insert(Latencies[i]);
+    for(int t = 1; t < 4; t++) perThread[0].merge(perThread[t]);
+    ASSERT_EQ(perThread[0].count(), SIZE);
+    ASSERT_NEAR(exactRank(perThread[0].quantile(0.5)), 0.5, 0.02);
+}
+
+/* ========================================== T-Digest =========================================================*/
+
+TEST_F(StreamingStatisticsTest, tdigestQuantiles) {
+    TDigest<double> digest;
+    ASSERT_THROW(digest.rank(1), std::runtime_error);
+    for(double latency: Latencies) digest.insert(latency);
+    ASSERT_EQ(digest.count(), SIZE);
+    ASSERT_LE(digest.retained(), 100);
+    ASSERT_EQ(digest.quantile(0), Sorted.front());
+    ASSERT_EQ(digest.quantile(1), Sorted.back());
+    for(double q: {0.5, 0.9}) {
+        ASSERT_NEAR(exactRank(digest.quantile(q)), q, 0.01);
+    }
+    // the tails are the most accurate
+    for(double q: {0.001, 0.99, 0.999}) {
+        ASSERT_NEAR(exactRank(digest.quantile(q)), q, 0.002);
+        ASSERT_NEAR(digest.rank(Sorted[(int) (q * SIZE)]), q, 0.002);
+    }
+}
+
+TEST_F(StreamingStatisticsTest, tdigestMerge) {
+    std::vector<TDigest<double>> perThread(4);
+    for(int i = 0; i < SIZE; i++) perThread[i % 4].insert(Latencies[i]);
+    for(int t = 1; t < 4; t++) perThread[0].merge(perThread[t]);
+    ASSERT_EQ(perThread[0].count(), SIZE);
+    ASSERT_NEAR(exactRank(perThread[0].quantile(0.99)), 0.99, 0.002);
+    ASSERT_THROW(perThread[0].insert(std::nan("")), std::invalid_argument);
+}
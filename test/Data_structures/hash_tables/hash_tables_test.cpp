@@ -0,0 +1,389 @@
+#include "gtest/gtest.h"
+#include "../../../include/Data_structures.hpp"
+
+#include<random>
+#include<span>
+#include<string>
+#include<string_view>
+#include<unordered_map>
+
+#define TEST_TABLE_SIZE 20000
+
+/*
+ * Unit Tests for the Hash Tables, checked against std::unordered_map
+ */
+class HashTablesTest : public ::testing::Test {
+public:
+    std::vector<std::pair<uint64_t, int>> operations{};
+protected:
+    void SetUp() override {
+        // inserts, removes and lookups over a small key range so that keys come and go
+        std::default_random_engine e(1234);
+        std::uniform_int_distribution<uint64_t> key(0, TEST_TABLE_SIZE / 4);
+        std::uniform_int_distribution<int> kind(0, 2);
+        for(int i = 0; i < TEST_TABLE_SIZE; i++) {
+            operations.emplace_back(key(e), kind(e));
+        }
+    }
+};
+
+/* ========================================== Open Addressing ================================================*/
+
+/*
+ * Same churn for every table. HashTableOA and HashTable keep duplicates so only absent keys are
+ * inserted, the tables whose insert returns whether it inserted get every key
+ */
+template<typename Table>
+static void churn(Table &table, const std::vector<std::pair<uint64_t, int>> &operations) {
+    std::unordered_map<uint64_t, int> expected;
+    for(size_t i = 0; i < operations.size(); i++) {
+        auto [key, kind] = operations[i];
+        if(kind == 0) {
+            if constexpr (std::same_as<decltype(table.insert(key, (int) i)), bool>) {
+                ASSERT_EQ(table.insert(key, (int) i), expected.emplace(key, (int) i).second);
+            } else {
+                if(expected.emplace(key, (int) i).second) table.insert(key, (int) i);
+            }
+        } else if(kind == 1) {
+            auto removed = table.remove(key);
+            ASSERT_EQ(removed.has_value(), expected.contains(key));
+            if(removed) {
+                ASSERT_EQ(*removed, expected[key]);
+                expected.erase(key);
+            }
+        } else {
+            auto found = table.get(key);
+            ASSERT_EQ(found.has_value(), expected.contains(key));
+            if(found) ASSERT_EQ(*found, expected[key]);
+            ASSERT_EQ(table.contains_key(key + 1), expected.contains(key + 1));
+        }
+        ASSERT_EQ(table.size(), expected.size());
+    }
+}
+
+TEST_F(HashTablesTest, openAddressingProbingPolicies) {
+    HashTableOA<uint64_t, int, probing::Linear> linear;
+    churn(linear, operations);
+    HashTableOA<uint64_t, int, probing::Quadratic> quadratic;
+    churn(quadratic, operations);
+    HashTableOA<uint64_t, int, probing::DoubleHashing> double_hashing;
+    churn(double_hashing, operations);
+}
+
+TEST_F(HashTablesTest, incrementalResize) {
+    HashTableOA<uint64_t, int> open_addressing(4, 0.8, true);
+    churn(open_addressing, operations);
+    HashTable<uint64_t, int> chained(3, 1.2, true);
+    churn(chained, operations);
+    // lookups see both tables while the entries move
+    HashTableOA<int, int> table(1024, 0.5, true);
+    HashTable<int, int> chains(1024, 0.5, true);
+    for(int i = 0; i <= 512; i++) {
+        table.insert(i, i);
+        chains.insert(i, i);
+    }
+    ASSERT_TRUE(table.rehashing());
+    ASSERT_TRUE(chains.rehashing());
+    for(int i = 0; i <= 512; i++) {
+        ASSERT_EQ(*table.get(i), i);
+        ASSERT_EQ(*chains.get(i), i);
+    }
+    ASSERT_TRUE(chains.update(0, -1));
+    ASSERT_EQ(*chains.remove(0), -1);
+    ASSERT_EQ(*table.remove(512), 512);
+    for(int i = 513; table.rehashing(); i++) table.insert(i, i);
+    ASSERT_EQ(*table.get(1), 1);
+    ASSERT_FALSE(table.contains_key(512));
+}
+
+/*
+ * Value counting its copies, the incremental resize should only move the entries
+ */
+struct CopyCounted {
+    static inline int copies = 0;
+    int value = 0;
+
+    CopyCounted() = default;
+    explicit CopyCounted(int value) : value(value) {}
+    CopyCounted(const CopyCounted &other) : value(other.value) { copies++; }
+    CopyCounted(CopyCounted&&) = default;
+    CopyCounted& operator=(const CopyCounted &other) { value = other.value; copies++; return *this; }
+    CopyCounted& operator=(CopyCounted&&) = default;
+};
+
+TEST_F(HashTablesTest, incrementalResizeMoves) {
+    HashTable<int, CopyCounted> chained(4, 1.0, true);
+    CopyCounted::copies = 0;
+    for(int i = 0; i < 1000; i++) chained.try_emplace(i, i);
+    while(chained.rehashing()) chained.contains_key(0);
+    ASSERT_EQ(CopyCounted::copies, 0);
+    ASSERT_EQ(chained.find(999)->value, 999);
+}
+
+/*
+ * Insert and remove churn fills every free slot with tombstones unless they count towards the resize
+ */
+TEST_F(HashTablesTest, openAddressingTombstones) {
+    for(bool incremental: {false, true}) {
+        HashTableOA<uint64_t, int> table(16, 0.8, incremental);
+        for(uint64_t key = 0; key < 100; key++) {
+            table.insert(key, (int) key);
+            ASSERT_TRUE(table.remove(key).has_value());
+        }
+        ASSERT_FALSE(table.contains_key(1000));
+        ASSERT_EQ(table.find(1000), nullptr);
+        for(uint64_t key = 100; key < 200; key++) {
+            ASSERT_TRUE(table.try_emplace(key, (int) key).second);
+            table[key + 1000] = 1;
+            ASSERT_TRUE(table.remove(key).has_value());
+            ASSERT_TRUE(table.remove(key + 1000).has_value());
+        }
+        ASSERT_TRUE(table.empty());
+        ASSERT_FALSE(table.contains_key(1000));
+    }
+}
+
+/* ========================================== Flat Hash Map ==================================================*/
+
+TEST_F(HashTablesTest, flatHashMapChurn) {
+    FlatHashMap<uint64_t, int> table;
+    churn(table, operations);
+    ASSERT_EQ(table.keys().size(), table.size());
+    ASSERT_EQ(table.bucket_count() & (table.bucket_count() - 1), 0);
+}
+
+TEST_F(HashTablesTest, flatHashMapStrings) {
+    FlatHashMap<std::string, std::string> table(4);
+    for(int i = 0; i < 1000; i++) {
+        ASSERT_TRUE(table.insert("session-" + std::to_string(i), std::to_string(i)));
+    }
+    ASSERT_FALSE(table.insert("session-7", "duplicate"));
+    ASSERT_TRUE(table.update("session-7", "seven"));
+    ASSERT_FALSE(table.update("session-1000", "missing"));
+    FlatHashMap<std::string, std::string> copy(table);
+    table.clear();
+    ASSERT_TRUE(table.empty());
+    ASSERT_FALSE(table.contains_key("session-3"));
+    ASSERT_EQ(copy.size(), 1000);
+    ASSERT_EQ(*copy.get("session-7"), "seven");
+    ASSERT_EQ(*copy.get("session-999"), "999");
+    FlatHashMap<std::string, std::string> moved(std::move(copy));
+    ASSERT_EQ(moved.size(), 1000);
+    ASSERT_TRUE(copy.insert("session-1", "reused"));
+    ASSERT_EQ(*copy.get("session-1"), "reused");
+}
+
+/* ========================================== Robin Hood Hash Table ==========================================*/
+
+TEST_F(HashTablesTest, robinHoodChurn) {
+    RobinHoodHashTable<uint64_t, int> table;
+    churn(table, operations);
+    auto histogram = table.probe_histogram();
+    ASSERT_EQ(std::accumulate(histogram.begin(), histogram.end(), (size_t) 0), table.size());
+    // no tombstones, removing everything leaves an empty table
+    for(auto key: table.keys()) {
+        ASSERT_TRUE(table.remove(key).has_value());
+    }
+    ASSERT_TRUE(table.empty());
+    ASSERT_TRUE(table.probe_histogram().empty());
+}
+
+TEST_F(HashTablesTest, robinHoodStrings) {
+    RobinHoodHashTable<std::string, std::string> table(4, 0.95);
+    for(int i = 0; i < 1000; i++) {
+        ASSERT_TRUE(table.insert("session-" + std::to_string(i), std::to_string(i)));
+    }
+    ASSERT_FALSE(table.insert("session-7", "duplicate"));
+    ASSERT_TRUE(table.update("session-7", "seven"));
+    RobinHoodHashTable<std::string, std::string> copy(table);
+    table.clear();
+    ASSERT_FALSE(table.contains_key("session-3"));
+    ASSERT_EQ(*copy.get("session-7"), "seven");
+    ASSERT_EQ(*copy.remove("session-999"), "999");
+    ASSERT_EQ(copy.size(), 999);
+    ASSERT_THROW((RobinHoodHashTable<int, int>(16, 1.0)), std::invalid_argument);
+}
+
+/* ========================================== Pooled Hash Table ==============================================*/
+
+TEST_F(HashTablesTest, pooledChurn) {
+    PooledHashTable<uint64_t, int> table;
+    churn(table, operations);
+    // released nodes are reused
+    size_t size = table.size();
+    for(auto key: table.keys()) {
+        ASSERT_NE(table.find(key), nullptr);
+        ASSERT_TRUE(table.remove(key).has_value());
+        ASSERT_EQ(table.find(key), nullptr);
+    }
+    ASSERT_TRUE(table.empty());
+    for(uint64_t key = 0; key < size; key++) {
+        ASSERT_TRUE(table.insert(key, (int) key));
+    }
+    ASSERT_FALSE(table.insert(3, 0));
+    ASSERT_EQ(table.size(), size);
+}
+
+TEST_F(HashTablesTest, pooledStrings) {
+    PooledHashTable<std::string, std::string> table(4);
+    for(int i = 0; i < 1000; i++) {
+        ASSERT_TRUE(table.insert("session-" + std::to_string(i), std::to_string(i)));
+    }
+    *table.find("session-7") = "seven";
+    PooledHashTable<std::string, std::string> copy(table);
+    table.clear();
+    ASSERT_FALSE(table.contains_key("session-7"));
+    ASSERT_EQ(*copy.get("session-7"), "seven");
+    ASSERT_EQ(*copy.remove("session-999"), "999");
+    ASSERT_TRUE(copy.update("session-1", "one"));
+    PooledHashTable<std::string, std::string> moved(std::move(copy));
+    ASSERT_EQ(moved.size(), 999);
+    ASSERT_EQ(*moved.find("session-1"), "one");
+    table = moved;
+    ASSERT_EQ(table.size(), 999);
+}
+
+/* ========================================== Heterogeneous Lookup ===========================================*/
+
+/*
+ * String keys looked up through views and literals, values built in place by try_emplace
+ */
+template<typename Table>
+static void heterogeneous_lookup(Table &table) {
+    using namespace std::literals;
+    for(int i = 0; i < 1000; i++) {
+        auto [data, inserted] = table.try_emplace("config." + std::to_string(i), 2, i);
+        ASSERT_TRUE(inserted);
+        ASSERT_EQ(*data, std::vector<int>(2, i));
+    }
+    auto [data, inserted] = table.try_emplace("config.7"sv, 5, 0);
+    ASSERT_FALSE(inserted);
+    ASSERT_EQ(data->size(), 2);
+    std::string line = "key=config.42;";
+    std::string_view key = std::string_view(line).substr(4, 9);
+    ASSERT_TRUE(table.contains_key(key));
+    ASSERT_EQ(*table.find(key), std::vector<int>(2, 42));
+    table.find(key)->push_back(0);
+    ASSERT_EQ(table.get(key)->size(), 3);
+    ASSERT_EQ(table.find("config.1000"), nullptr);
+    table["config.1000"].push_back(1);
+    ASSERT_EQ(table["config.1000"], std::vector<int>{1});
+    ASSERT_TRUE(table.emplace("config.1001", std::vector<int>{4}).second);
+    ASSERT_FALSE(table.emplace(std::string("config.1001"), std::vector<int>{5}).second);
+    ASSERT_TRUE(table.update("config.1001"sv, std::vector<int>{6}));
+    ASSERT_EQ(table.remove("config.1001"sv)->front(), 6);
+    ASSERT_EQ(table.size(), 1001);
+}
+
+TEST_F(HashTablesTest, heterogeneousLookup) {
+    HashTable<std::string, std::vector<int>> chained;
+    heterogeneous_lookup(chained);
+    HashTable<std::string, std::vector<int>> chained_incremental(3, 1.2, true);
+    heterogeneous_lookup(chained_incremental);
+    HashTableOA<std::string, std::vector<int>> open_addressing;
+    heterogeneous_lookup(open_addressing);
+    HashTableOA<std::string, std::vector<int>> open_addressing_incremental(4, 0.8, true);
+    heterogeneous_lookup(open_addressing_incremental);
+    FlatHashMap<std::string, std::vector<int>> flat;
+    heterogeneous_lookup(flat);
+    RobinHoodHashTable<std::string, std::vector<int>> robin_hood;
+    heterogeneous_lookup(robin_hood);
+    PooledHashTable<std::string, std::vector<int>> pooled;
+    heterogeneous_lookup(pooled);
+}
+
+TEST_F(HashTablesTest, subscriptCounts) {
+    std::unordered_map<uint64_t, int> expected;
+    HashTableOA<uint64_t, int> open_addressing;
+    RobinHoodHashTable<uint64_t, int> robin_hood;
+    for(auto [key, kind]: operations) {
+        expected[key] += kind;
+        open_addressing[key] += kind;
+        robin_hood[key] += kind;
+    }
+    ASSERT_EQ(open_addressing.size(), expected.size());
+    ASSERT_EQ(robin_hood.size(), expected.size());
+    for(auto [key, count]: expected) {
+        ASSERT_EQ(*open_addressing.find(key), count);
+        ASSERT_EQ(*robin_hood.find(key), count);
+    }
+}
+
+/* ========================================== Hash Functions =================================================*/
+
+TEST_F(HashTablesTest, wyHash) {
+    hashing::WyHash hash, salted(42);
+    std::string key = "config.service-7.timeout_ms";
+    ASSERT_EQ(hash(key), hash(std::string_view(key)));
+    ASSERT_EQ(hash(key), hash(std::as_bytes(std::span(key.data(), key.size()))));
+    ASSERT_NE(hash(key), salted(key));
+    ASSERT_EQ(salted(key), hashing::WyHash(42)(key));
+    ASSERT_NE(hash(""), hash(std::string_view("\0", 1)));
+    // strided keys: std::hash leaves them all in one of 1024 buckets
+    std::vector<bool> bucket(1024, false);
+    size_t used = 0;
+    for(uint64_t i = 0; i < 1024; i++) {
+        size_t b = hash(i << 20) & 1023;
+        used += !bucket[b];
+        bucket[b] = true;
+    }
+    ASSERT_GT(used, 600);
+    ASSERT_NE(hashing::hash_combine(hashing::hash_combine(0, 1), 2), hashing::hash_combine(hashing::hash_combine(0, 2), 1));
+}
+
+TEST_F(HashTablesTest, pluggableHash) {
+    HashTableOA<uint64_t, int, probing::Linear, hashing::WyHash> open_addressing(4, 0.8, false, hashing::WyHash::seeded());
+    churn(open_addressing, operations);
+    HashTable<uint64_t, int, hashing::WyHash> chained(3, 1.2, true, hashing::WyHash(7));
+    churn(chained, operations);
+    FlatHashMap<uint64_t, int> flat(16, hashing::WyHash::seeded());
+    churn(flat, operations);
+    RobinHoodHashTable<uint64_t, int> robin_hood(16, 0.875, hashing::WyHash(7));
+    churn(robin_hood, operations);
+    PooledHashTable<uint64_t, int, std::hash<uint64_t>> pooled;
+    churn(pooled, operations);
+    HashTableOA<std::string, int, probing::Quadratic, hashing::WyHash> strings;
+    strings["session-1"] = 1;
+    ASSERT_EQ(*strings.find(std::string_view("session-1")), 1);
+    // keys without a WyHash overload go through their std::hash
+    FlatHashMap<double, int> doubles;
+    doubles[0.5] = 1;
+    doubles[-0.0] = 2;
+    ASSERT_EQ(*doubles.find(0.0), 2);
+    ASSERT_EQ(doubles.size(), 2);
+    size_t count = 0;
+    for(auto probes: open_addressing.probe_histogram()) count += probes;
+    ASSERT_EQ(count, open_addressing.size());
+}
+
+/*
+ * Composite key hashed by combining the hashes of its fields
+ */
+struct GridCell {
+    int x, y;
+
+    bool operator==(const GridCell&) const = default;
+};
+
+struct GridCellHash {
+    hashing::WyHash hash;
+
+    size_t operator()(const GridCell &cell) const {
+        return hashing::hash_combine(hash(cell.x), hash(cell.y));
+    }
+};
+
+TEST_F(HashTablesTest, compositeKey) {
+    HashTableOA<GridCell, int, probing::Linear, GridCellHash> table;
+    for(int x = 0; x < 64; x++) {
+        for(int y = 0; y < 64; y++) ASSERT_TRUE(table.try_emplace(GridCell{x, y}, x * 64 + y).second);
+    }
+    ASSERT_FALSE(table.try_emplace(GridCell{3, 5}, 0).second);
+    ASSERT_EQ(*table.get(GridCell{3, 5}), 3 * 64 + 5);
+    ASSERT_FALSE(table.contains_key(GridCell{5, 64}));
+    ASSERT_EQ(table.size(), 64 * 64);
+    FlatHashMap<GridCell, int, GridCellHash> flat;
+    flat[GridCell{3, 5}] = 1;
+    ASSERT_EQ(*flat.find(GridCell{3, 5}), 1);
+    ASSERT_EQ(flat.find(GridCell{5, 3}), nullptr);
+}